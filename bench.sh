@@ -0,0 +1,20 @@
+#!/bin/bash
+# Runs the benchmark suite from the release build, saves the results in
+# bench/ named after machine and revision, and compares them with
+# bench/baseline.json if there is one. Exits non-zero on a regression.
+# Extra arguments go to the benchmark binary, e.g. ./bench.sh score osc
+(
+  cmake -S . -B build/release -DCMAKE_BUILD_TYPE=Release -Wno-deprecated -DBUILD_EXAMPLES=0 > /dev/null &&
+  cmake --build build/release --target benchmark -j 5
+) || exit 2
+
+mkdir -p bench
+revision=$(git rev-parse --short HEAD 2>/dev/null || echo unknown)
+result="bench/$(hostname)-${revision}.json"
+
+if [ -f bench/baseline.json ]; then
+  ./bin/benchmark --json "${result}" --baseline bench/baseline.json "$@"
+else
+  ./bin/benchmark --json "${result}" "$@"
+  echo "no bench/baseline.json; copy ${result} there to start gating"
+fi
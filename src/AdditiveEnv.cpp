@@ -0,0 +1,126 @@
+#include <algorithm>
+#include <cmath>
+
+#include "AdditiveEnv.hpp"
+#include "VoiceVisuals.hpp"
+#include "RtSafety.hpp"
+
+void AdditiveEnv::init()
+{
+    // Intialize envelope (LinearEnv segments are always straight lines)
+    mAmpEnv.levels(0, 1, 1, 0);
+    mAmpEnv.sustainPoint(2); // Make point 2 sustain until a release is issued
+    // Spatializer buffers up front; the audio thread only reuses them
+    mSpatial.layout(SpeakerLayout::current());
+
+    addDisc(mMesh, 1.0, 30);
+
+    // Same trigger parameters as SineEnv, so the voices are
+    // interchangeable in playNote() and in presets, plus the spectrum.
+    createInternalTriggerParameter("amplitude", 0.25, 0.0, 1.0);
+    createInternalTriggerParameter("frequency", 60, 20, 5000);
+    createInternalTriggerParameter("attackTime", 1.0 / 77.0, 0.01, 3.0);
+    createInternalTriggerParameter("releaseTime", 1.0 / 77.0, 0.1, 10.0);
+    createInternalTriggerParameter("decayTime", 2.0 / 77.0, 0.1, 10.0);
+    createInternalTriggerParameter("pan", 0.0, -1.0, 1.0);
+    createInternalTriggerParameter("partials", 16, 1, SineBank::kMaxPartials);
+    createInternalTriggerParameter("rolloff", 1.0, 0.0, 4.0);
+    createInternalTriggerParameter("inharmonicity", 0.0, 0.0, 0.01);
+    createInternalTriggerParameter("partialDecay", 4.0, 0.0, 30.0); // 0: no decay
+}
+
+void AdditiveEnv::buildPartials(double sampleRate)
+{
+    const float freq = getInternalParameterValue("frequency");
+    const int count = (int)getInternalParameterValue("partials");
+    const float rolloff = getInternalParameterValue("rolloff");
+    const float inharmonicity = getInternalParameterValue("inharmonicity");
+    const float decay = getInternalParameterValue("partialDecay");
+
+    // Scale so the partials together peak near the voice's amplitude
+    float total = 0;
+    for (int k = 1; k <= count; k++) {
+        total += std::pow((float)k, -rolloff);
+    }
+    mPartials.clear();
+    for (int k = 1; k <= count; k++) {
+        const float ratio = k * std::sqrt(1.f + inharmonicity * k * k);
+        if (!mPartials.add(freq * ratio, std::pow((float)k, -rolloff) / total, decay / k, sampleRate)) {
+            break; // the rest are above Nyquist
+        }
+    }
+    mSampleRate = sampleRate;
+}
+
+void AdditiveEnv::onProcess(AudioIOData &io)
+{
+    RT_SAFETY_SCOPE("AdditiveEnv::onProcess");
+
+    // The spectrum is fixed per note; it only needs the device rate, which
+    // onTriggerOn doesn't know
+    if (mSampleRate != io.framesPerSecond()) {
+        buildPartials(io.framesPerSecond());
+    }
+    mAmpEnv.sampleRate(io.framesPerSecond());
+    mAmpEnv.lengths()[0] = getInternalParameterValue("attackTime");
+    mAmpEnv.lengths()[2] = getInternalParameterValue("releaseTime");
+    mPan.pos(getInternalParameterValue("pan"));
+    float amp = getInternalParameterValue("amplitude");
+    float mono[kChunk], env[kChunk];
+    const int end = io.framesPerBuffer();
+    const SpeakerLayout *layout = SpeakerLayout::current();
+    const bool spatial = layout && io.channelsOut() > 2;
+    if (spatial) {
+        mSpatial.layout(layout);
+        mSpatial.position(getInternalParameterValue("pan") * 180.f);
+    }
+    for (int start = io.frame() + 1; start < end; start += kChunk)
+    {
+        const int n = std::min(kChunk, end - start);
+        std::fill(mono, mono + n, 0.f);
+        mPartials.render(mono, n);
+        mAmpEnv.process(env, n);
+        for (int i = 0; i < n; i++)
+        {
+            mono[i] *= env[i] * amp;
+        }
+        if (spatial) {
+            mSpatial.mix(mono, n, io, start);
+            continue;
+        }
+        for (int i = 0; i < n; i++)
+        {
+            float s1 = mono[i];
+            float s2;
+            mPan(s1, s1, s2);
+            io.out(0, start + i) += s1;
+            io.out(1, start + i) += s2;
+        }
+    }
+    // Free on release, or once every partial has died away
+    if (mAmpEnv.done() || mPartials.silent(1e-5f))
+        free();
+}
+
+void AdditiveEnv::onProcess(Graphics &g)
+{
+    float frequency = getInternalParameterValue("frequency");
+    float amplitude = getInternalParameterValue("amplitude");
+    g.pushMatrix();
+    const VoiceGlyph v = VoiceGlyph::make(frequency, amplitude, mAmpEnv.value() * amplitude);
+    g.translate(v.x, v.y, v.z);
+    g.scale(v.sx, v.sy, 1);
+    g.color(v.r, v.g, v.b, v.a);
+    g.draw(mMesh);
+    g.popMatrix();
+}
+
+void AdditiveEnv::onTriggerOn()
+{
+    mAmpEnv.reset();
+    mSpatial.reset();
+    // Rebuilt with the new note's parameters on the next block
+    mSampleRate = 0;
+}
+
+void AdditiveEnv::onTriggerOff() { mAmpEnv.release(); }
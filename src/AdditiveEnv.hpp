@@ -0,0 +1,60 @@
+#ifndef ADDITIVEENV_HPP
+#define ADDITIVEENV_HPP
+
+#include "Gamma/Analysis.h"
+#include "Gamma/Effects.h"
+#include "Gamma/Envelope.h"
+
+#include "al/app/al_App.hpp"
+#include "al/graphics/al_Shapes.hpp"
+#include "al/scene/al_PolySynth.hpp"
+#include "al/scene/al_SynthSequencer.hpp"
+#include "al/ui/al_Parameter.hpp"
+
+#include "LinearEnv.hpp"
+#include "SineBank.hpp"
+#include "Spatializer.hpp"
+
+using namespace al;
+
+// SineEnv with a stack of partials in place of the single sine. Partial k
+// (from 1) sits at k * sqrt(1 + inharmonicity * k^2) times the frequency,
+// at 1 / k^rolloff of the fundamental's level, and dies away 60 dB over
+// partialDecay / k seconds, so upper partials fade first as in a struck
+// string. All partials render together through SineBank's SIMD kernel.
+class AdditiveEnv : public SynthVoice {
+    public:
+        // Unit generators
+        gam::Pan<> mPan;
+        SineBank mPartials;
+        LinearEnv<3> mAmpEnv;
+        // Used instead of mPan when the device has more than two outputs
+        Spatializer mSpatial;
+
+        // Additional members
+        Mesh mMesh;
+
+        // Samples rendered per pass of the audio loop
+        static const int kChunk = 64;
+
+        // Initialize voice. This function will only be called once per voice when
+        // it is created. Voices will be reused if they are idle.
+        void init() override;
+
+        // The audio processing function
+        void onProcess(AudioIOData& io) override;
+
+        // The graphics processing function
+        void onProcess(Graphics& g) override;
+
+        void onTriggerOn() override;
+        void onTriggerOff() override;
+
+    private:
+        // Lay out the partials for the current parameters
+        void buildPartials(double sampleRate);
+
+        double mSampleRate = 0; // the partials were built for
+};
+
+#endif
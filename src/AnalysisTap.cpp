@@ -0,0 +1,191 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#ifdef __linux__
+#include <sys/resource.h>
+#endif
+
+#include "AnalysisTap.hpp"
+
+namespace {
+    // In-place radix-2 FFT; n is a power of two
+    void fft(float *re, float *im, int n)
+    {
+        for (int i = 1, j = 0; i < n; i++) {
+            int bit = n >> 1;
+            for (; j & bit; bit >>= 1) {
+                j ^= bit;
+            }
+            j ^= bit;
+            if (i < j) {
+                std::swap(re[i], re[j]);
+                std::swap(im[i], im[j]);
+            }
+        }
+        for (int len = 2; len <= n; len <<= 1) {
+            const double angle = -2 * M_PI / len;
+            const float wRe = (float)std::cos(angle), wIm = (float)std::sin(angle);
+            for (int i = 0; i < n; i += len) {
+                float uRe = 1, uIm = 0;
+                for (int k = 0; k < len / 2; k++) {
+                    const int a = i + k, b = a + len / 2;
+                    const float tRe = re[b] * uRe - im[b] * uIm;
+                    const float tIm = re[b] * uIm + im[b] * uRe;
+                    re[b] = re[a] - tRe;
+                    im[b] = im[a] - tIm;
+                    re[a] += tRe;
+                    im[a] += tIm;
+                    const float next = uRe * wRe - uIm * wIm;
+                    uIm = uRe * wIm + uIm * wRe;
+                    uRe = next;
+                }
+            }
+        }
+    }
+
+    float toDb(float power) { return 10.f * std::log10(std::max(power, 1e-12f)); }
+}
+
+void AnalysisTap::start(int channels, double sampleRate)
+{
+    stop();
+    mChannels = channels;
+    mSampleRate = sampleRate;
+    mRing.resize((size_t)(sampleRate / 2)); // half a second of mono
+    mWindow.resize(kFftSize);
+    for (int i = 0; i < kFftSize; i++) {
+        mWindow[i] = 0.5f - 0.5f * (float)std::cos(2 * M_PI * i / kFftSize);
+    }
+    mHistory.assign(kFftSize, 0.f);
+    mRe.resize(kFftSize);
+    mIm.resize(kFftSize);
+    mPeak = 0;
+    mDroppedFrames = 0;
+    mRunning = true;
+    mThread = std::thread(&AnalysisTap::run, this);
+}
+
+void AnalysisTap::stop()
+{
+    if (!mRunning.exchange(false)) {
+        return;
+    }
+    mThread.join();
+}
+
+void AnalysisTap::process(const AudioIOData &io)
+{
+    if (!mRunning) {
+        return;
+    }
+    const int frames = io.framesPerBuffer();
+    if (mRing.writeAvailable() < (size_t)frames) {
+        mDroppedFrames.fetch_add(frames, std::memory_order_relaxed);
+        return;
+    }
+    const int channels = std::min(mChannels, io.channelsOut());
+    const float scale = 1.f / std::max(1, channels);
+    for (int i = 0; i < frames; i++) {
+        mRing.writeSlot(i) = 0.f;
+    }
+    for (int c = 0; c < channels; c++) {
+        const float *src = io.outBuffer(c);
+        for (int i = 0; i < frames; i++) {
+            mRing.writeSlot(i) += src[i] * scale;
+        }
+    }
+    mRing.commitWrite(frames);
+}
+
+bool AnalysisTap::latest(Analysis &out)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    if (!mFresh) {
+        return false;
+    }
+    out = mLatest;
+    mFresh = false;
+    return true;
+}
+
+void AnalysisTap::run()
+{
+#ifdef __linux__
+    // Below the UI and far below the audio thread; on Linux this only
+    // affects the calling thread
+    setpriority(PRIO_PROCESS, 0, 10);
+#endif
+    Analysis a;
+    float hop[kHop];
+    while (mRunning) {
+        if (mRing.readAvailable() < (size_t)kHop) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            continue;
+        }
+        mRing.read(hop, kHop);
+        std::copy(mHistory.begin() + kHop, mHistory.end(), mHistory.begin());
+        std::copy(hop, hop + kHop, mHistory.end() - kHop);
+        for (float x : hop) {
+            mPeak = std::max(mPeak, std::fabs(x));
+        }
+        a.frames += kHop;
+        analyse(a);
+
+        std::lock_guard<std::mutex> lock(mLock);
+        mLatest = a;
+        mFresh = true;
+    }
+}
+
+void AnalysisTap::analyse(Analysis &a)
+{
+    double sum = 0;
+    for (int i = 0; i < kFftSize; i++) {
+        sum += mHistory[i] * mHistory[i];
+        mRe[i] = mHistory[i] * mWindow[i];
+        mIm[i] = 0;
+    }
+    a.rms = (float)std::sqrt(sum / kFftSize);
+    a.peak = mPeak;
+    mPeak = 0;
+
+    fft(mRe.data(), mIm.data(), kFftSize);
+    // Power per bin, scaled so a full-scale sine reads 0 dB (the Hann
+    // window's coherent gain is 1/2)
+    const int bins = kFftSize / 2;
+    const float norm = 4.f / kFftSize;
+    for (int k = 0; k < bins; k++) {
+        mRe[k] = (mRe[k] * mRe[k] + mIm[k] * mIm[k]) * norm * norm;
+    }
+    const float binHz = (float)(mSampleRate / kFftSize);
+
+    for (int b = 0; b < Analysis::kBands; b++) {
+        const float centre = Analysis::bandCentre(b);
+        const int lo = std::max(1, (int)std::ceil(centre / std::sqrt(2.f) / binHz));
+        const int hi = std::min(bins - 1, (int)std::floor(centre * std::sqrt(2.f) / binHz));
+        float power = 0;
+        for (int k = lo; k <= hi; k++) {
+            power += mRe[k];
+        }
+        // Summing bins counts the window's 1.5 bin noise bandwidth
+        a.bands[b] = toDb(power / 1.5f);
+    }
+
+    // Display bins: the loudest FFT bin in each, or the nearest one where
+    // a display bin is narrower than an FFT bin
+    const float nyquist = (float)(mSampleRate / 2);
+    const float ratio = std::pow(nyquist / 20.f, 1.f / Analysis::kSpectrumBins);
+    float edge = 20.f;
+    for (int s = 0; s < Analysis::kSpectrumBins; s++) {
+        const float next = edge * ratio;
+        int lo = std::max(1, (int)(edge / binHz));
+        const int hi = std::min(bins - 1, std::max(lo, (int)(next / binHz)));
+        float power = 0;
+        for (int k = lo; k <= hi; k++) {
+            power = std::max(power, mRe[k]);
+        }
+        a.spectrum[s] = toDb(power);
+        edge = next;
+    }
+}
@@ -0,0 +1,79 @@
+#ifndef ANALYSISTAP_HPP
+#define ANALYSISTAP_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "al/io/al_AudioIOData.hpp"
+
+#include "RingBuffer.hpp"
+
+using namespace al;
+
+// Meters and spectrum of the master bus, for drawing and for OSC.
+struct Analysis {
+    static const int kBands = 10;         // octaves centred on 31.25 Hz to 16 kHz
+    static const int kSpectrumBins = 128; // log spaced, 20 Hz to Nyquist
+
+    float rms = 0;  // linear, over the last analysis window
+    float peak = 0; // linear, largest sample since the previous window
+    float bands[kBands] = {};                // dBFS
+    float spectrum[kSpectrumBins] = {};      // dBFS
+    uint64_t frames = 0;                     // analysed since start()
+
+    static float bandCentre(int band) { return 31.25f * (1 << band); }
+};
+
+// One analysis tap on the master bus, in place of an envelope follower
+// per voice. process() runs at the end of the audio callback and only
+// copies a mono downmix of the block into a ring buffer, so its cost
+// doesn't depend on the number of voices. A low-priority thread takes
+// kHop frames at a time, windows the last kFftSize, and computes the
+// meters, an FFT spectrum and octave band energies; latest() hands the
+// newest result to the graphics thread. If the analysis thread falls
+// behind, blocks are dropped and counted rather than delaying the audio.
+class AnalysisTap {
+    public:
+        static const int kFftSize = 2048;
+        static const int kHop = 1024;
+
+        ~AnalysisTap() { stop(); }
+
+        void start(int channels, double sampleRate);
+        void stop();
+        bool running() const { return mRunning; }
+
+        // Audio thread
+        void process(const AudioIOData &io);
+
+        // Copy the newest analysis into out. Returns false if there has
+        // been none since the last call.
+        bool latest(Analysis &out);
+        uint64_t droppedFrames() const { return mDroppedFrames; }
+
+    private:
+        void run();
+        void analyse(Analysis &a);
+
+        RingBuffer<float> mRing;
+        std::thread mThread;
+        std::atomic<bool> mRunning{false};
+        std::atomic<uint64_t> mDroppedFrames{0};
+        int mChannels = 0;
+        double mSampleRate = 0;
+
+        // Analysis thread
+        std::vector<float> mWindow;  // Hann
+        std::vector<float> mHistory; // last kFftSize frames
+        std::vector<float> mRe, mIm;
+        float mPeak = 0;
+
+        std::mutex mLock; // between the analysis and graphics threads only
+        Analysis mLatest;
+        bool mFresh = false;
+};
+
+#endif
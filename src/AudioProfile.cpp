@@ -0,0 +1,48 @@
+#include <cstdio>
+
+#include "AudioProfile.hpp"
+
+namespace {
+    const AudioProfile builtinProfiles[] = {
+        // name       rate     block  sub
+        {"default",   48000.,  512,   512},
+        {"safe",      48000.,  512,   64},
+        {"low",       48000.,  256,   64},
+        {"ultra",     48000.,  128,   32},
+        {"studio",    96000.,  256,   32},
+    };
+}
+
+bool AudioProfile::find(const std::string &spec, AudioProfile &p)
+{
+    for (const auto &builtin : builtinProfiles) {
+        if (builtin.name == spec) {
+            p = builtin;
+            return true;
+        }
+    }
+
+    double rate;
+    int block, sub = 0;
+    int fields = sscanf(spec.c_str(), "%lf/%d/%d", &rate, &block, &sub);
+    if (fields < 2 || rate <= 0 || block <= 0) {
+        return false;
+    }
+    if (fields < 3 || sub <= 0 || sub > block || block % sub != 0) {
+        sub = block;
+    }
+    p.name = spec;
+    p.sampleRate = rate;
+    p.blockSize = block;
+    p.subBlockSize = sub;
+    return true;
+}
+
+std::string AudioProfile::names()
+{
+    std::string result;
+    for (const auto &builtin : builtinProfiles) {
+        result += (result.empty() ? "" : ", ") + builtin.name;
+    }
+    return result;
+}
@@ -0,0 +1,76 @@
+#ifndef AUDIOPROFILE_HPP
+#define AUDIOPROFILE_HPP
+
+#include <algorithm>
+#include <string>
+
+#include "al/io/al_AudioIOData.hpp"
+
+using namespace al;
+
+// Device and scheduling settings selected at startup. The device block
+// size trades xrun safety for latency; the sub-block size sets how finely
+// events and voices are rendered inside one device block.
+struct AudioProfile {
+    std::string name;
+    double sampleRate;
+    int blockSize;    // frames per device callback
+    int subBlockSize; // frames per synth render, divides blockSize
+
+    // Built-in profiles ("default", "low", "ultra", ...) or a custom
+    // "rate/block/sub" string such as "48000/256/32". Returns false and
+    // leaves p untouched if spec can't be parsed.
+    static bool find(const std::string &spec, AudioProfile &p);
+
+    // Comma-separated list of the built-in profile names
+    static std::string names();
+
+    // Output latency implied by one device buffer, in milliseconds
+    double blockMs() const { return 1000.0 * blockSize / sampleRate; }
+};
+
+// Splits each device block into fixed-size sub-blocks and renders them
+// one after the other through a scratch buffer, so anything driven by the
+// render callback (sequencer events, voice starts) advances in
+// sub-block steps. The scratch buffer is allocated once in configure().
+class SubBlockRenderer {
+    public:
+        void configure(int subBlockSize, double sampleRate, int channelsOut) {
+            mSize = subBlockSize;
+            mChannels = channelsOut;
+            mIO.framesPerSecond(sampleRate);
+            mIO.framesPerBuffer(std::max(subBlockSize, 1));
+            mIO.channels(channelsOut, true);
+        }
+
+        int size() const { return mSize; }
+
+        template <class RenderFunc>
+        void render(AudioIOData &io, RenderFunc &&renderFunc) {
+            const int frames = io.framesPerBuffer();
+            if (mSize <= 0 || mSize >= frames || frames % mSize != 0) {
+                renderFunc(io);
+                return;
+            }
+            const int channels = std::min(mChannels, io.channelsOut());
+            for (int offset = 0; offset < frames; offset += mSize) {
+                mIO.zeroOut();
+                mIO.frame(0);
+                renderFunc(mIO);
+                for (int c = 0; c < channels; c++) {
+                    const float *src = mIO.outBuffer(c);
+                    float *dst = io.outBuffer(c) + offset;
+                    for (int i = 0; i < mSize; i++) {
+                        dst[i] += src[i];
+                    }
+                }
+            }
+        }
+
+    private:
+        AudioIOData mIO;
+        int mSize = 0;
+        int mChannels = 0;
+};
+
+#endif
@@ -0,0 +1,478 @@
+/*
+Offline benchmarks for the synthesis and scheduling code. Voices are
+driven directly, without an audio device, so results only reflect the
+cost of our own code.
+
+Usage: benchmark [options] [name ...]    (no names runs everything)
+  --repeat N          runs per benchmark (default 5)
+  --json FILE         save results, tagged with git revision and machine
+  --baseline FILE     compare with saved results; exit 1 on regression
+  --tolerance X       relative slowdown allowed (default 0.05)
+  --sigmas X          noise allowance in standard deviations (default 3)
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Gamma/Domain.h"
+
+#include "al/protocol/al_OSC.hpp"
+#include "al/scene/al_SynthSequencer.hpp"
+
+#include "AdditiveEnv.hpp"
+#include "BenchmarkReport.hpp"
+#include "NoteScheduler.hpp"
+#include "OfflineRender.hpp"
+#include "PackedScore.hpp"
+#include "ParallelRender.hpp"
+#include "Score.hpp"
+#include "ScorePlayer.hpp"
+#include "SineBank.hpp"
+#include "SineEnv.hpp"
+#include "Spatializer.hpp"
+#include "WavetableEnv.hpp"
+
+#ifndef GIT_REVISION
+#define GIT_REVISION "unknown"
+#endif
+
+using Clock = std::chrono::steady_clock;
+
+const double kSampleRate = 48000.;
+const int kBlockSize = 512;
+
+BenchmarkReport report;
+
+// Render numVoices voices of type T for numBlocks blocks into a scratch
+// buffer of `channels` outputs and return nanoseconds per voice-sample.
+template <class T>
+double timeVoices(int numVoices, int numBlocks, std::function<void(T &, int)> setup,
+                  int channels = 2)
+{
+    AudioIOData io;
+    io.framesPerSecond(kSampleRate);
+    io.framesPerBuffer(kBlockSize);
+    io.channels(channels, true);
+
+    std::vector<std::unique_ptr<T>> voices;
+    for (int v = 0; v < numVoices; v++) {
+        voices.emplace_back(new T);
+        voices[v]->init();
+        voices[v]->setInternalParameterValue("amplitude", 0.5f / numVoices);
+        voices[v]->setInternalParameterValue("frequency", 55.f * (1 + v % 48));
+        setup(*voices[v], v);
+        voices[v]->triggerOn();
+    }
+
+    auto start = Clock::now();
+    for (int b = 0; b < numBlocks; b++) {
+        io.zeroOut();
+        for (auto &voice : voices) {
+            io.frame(0);
+            voice->onProcess(io);
+        }
+    }
+    std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+    return elapsed.count() / ((double)numVoices * numBlocks * kBlockSize);
+}
+
+// WavetableEnv against the gam::Sine path in SineEnv, 64 voices
+void benchWavetable()
+{
+    const int numVoices = 64;
+    const int numBlocks = 2000;
+
+    report.add("wavetable.SineEnv", "ns/voice-sample",
+               timeVoices<SineEnv>(numVoices, numBlocks, [](SineEnv &, int) {}));
+
+    const char *names[] = {"sine", "triangle", "square", "saw"};
+    for (int interp = WavetableOsc::LINEAR; interp <= WavetableOsc::CUBIC; interp++) {
+        for (int w = 0; w < Wavetable::NUM_WAVEFORMS; w++) {
+            double ns = timeVoices<WavetableEnv>(numVoices, numBlocks, [&](WavetableEnv &voice, int) {
+                voice.setInternalParameterValue("waveform", w);
+                voice.setInternalParameterValue("interpolation", interp);
+            });
+            std::string name = std::string("wavetable.") + names[w] +
+                               (interp == WavetableOsc::LINEAR ? ".linear" : ".cubic");
+            report.add(name, "ns/voice-sample", ns);
+        }
+    }
+}
+
+// A held 128-voice SineEnv chord, the shape of the polyphony stress test
+void benchChord()
+{
+    report.add("chord.SineEnv", "ns/voice-sample",
+               timeVoices<SineEnv>(128, 1000, [](SineEnv &, int) {}));
+}
+
+// The whole sequence() score rendered offline, note by note
+void benchScore()
+{
+    Sequence *score = sequence(1.0);
+    OfflineRenderer renderer(kSampleRate, BPM);
+    StereoBuffer out;
+
+    auto start = Clock::now();
+    renderer.render(*score, out);
+    std::chrono::duration<double, std::milli> elapsed = Clock::now() - start;
+    delete score;
+
+    report.add("score.render", "ms", elapsed.count());
+    report.add("score.SineEnv", "ns/voice-sample", elapsed.count() * 1e6 / renderer.voiceFrames());
+}
+
+// Eight transpositions of the score rendered phrase-parallel, on one
+// thread and on every core
+void benchParallel()
+{
+    std::vector<int> threadCounts = {1};
+    if (std::thread::hardware_concurrency() > 1) {
+        threadCounts.push_back(std::thread::hardware_concurrency());
+    }
+    for (int threads : threadCounts) {
+        std::vector<ScoreRender> renders(8);
+        for (size_t i = 0; i < renders.size(); i++) {
+            renders[i].offset = 1.0f + 0.125f * i;
+            renders[i].bpm = BPM;
+        }
+        ParallelRenderer renderer(kSampleRate, threads);
+        auto start = Clock::now();
+        renderer.render(renders);
+        std::chrono::duration<double, std::milli> elapsed = Clock::now() - start;
+        report.add("parallel.render." + std::to_string(threads), "ms", elapsed.count());
+    }
+}
+
+// A generated score of 10^6 notes as Notes and as PackedNotes: walking
+// every note, and compiling the whole score for ScorePlayer
+void benchPacked()
+{
+    const int numNotes = 1000000;
+    TimeSignature t;
+    Sequence notes(t);
+    notes.getNotes()->reserve(numNotes);
+    uint32_t seed = 12345;
+    float beat = 0;
+    for (int i = 0; i < numNotes; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        beat += (seed >> 28) / 16.f;
+        notes.add(Note(kConcertPitch.freq(36 + (seed >> 8) % 60), beat, 0.25f + (seed >> 20 & 7) / 4.f,
+                       0.05f + (seed >> 16 & 15) / 64.f, 0.01f, 0.05f));
+    }
+    PackedScore packed;
+    packed.add(notes);
+
+    report.add("packed.memory.Note", "MB", numNotes * sizeof(Note) / 1048576.0);
+    report.add("packed.memory.PackedNote", "MB", packed.bytes() / 1048576.0);
+
+    volatile float sink;
+    auto start = Clock::now();
+    float sum = 0;
+    for (const Note &n : *notes.getNotes()) {
+        sum += n.getFreq() * n.getAmp() * n.getDuration();
+    }
+    sink = sum;
+    std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+    report.add("packed.iterate.Note", "ns/note", elapsed.count() / numNotes);
+
+    start = Clock::now();
+    sum = 0;
+    for (const PackedNote &n : packed.notes()) {
+        sum += packed.freq(n) * PackedScore::amp(n) * PackedScore::beats(n.duration);
+    }
+    sink = sum;
+    elapsed = Clock::now() - start;
+    report.add("packed.iterate.PackedNote", "ns/note", elapsed.count() / numNotes);
+    (void)sink;
+
+    start = Clock::now();
+    CompiledScore::compile(notes, BPM, kSampleRate);
+    elapsed = Clock::now() - start;
+    report.add("packed.compile.Note", "ns/note", elapsed.count() / numNotes);
+
+    start = Clock::now();
+    CompiledScore::compile(packed, BPM, kSampleRate);
+    elapsed = Clock::now() - start;
+    report.add("packed.compile.PackedNote", "ns/note", elapsed.count() / numNotes);
+}
+
+// Scheduling the whole score the way MyApp::playNote() does: one voice
+// from the pool, five parameters and a sequencer insert per note.
+// Then the same score as one NoteScheduler batch, as playSequence() now does.
+void benchSchedule()
+{
+    Sequence *score = sequence(1.0);
+    SynthSequencer sequencer;
+    sequencer.synth().allocatePolyphony<SineEnv>(score->getNotes()->size());
+    float secondsPerBeat = 60.0f / BPM;
+
+    auto start = Clock::now();
+    for (auto &note : *score->getNotes()) {
+        SynthVoice *voice = sequencer.synth().getVoice<SineEnv>();
+        voice->setInternalParameterValue("amplitude", note.getAmp());
+        voice->setInternalParameterValue("frequency", note.getFreq());
+        voice->setInternalParameterValue("attackTime", 0.01);
+        voice->setInternalParameterValue("releaseTime", 0.05);
+        voice->setInternalParameterValue("pan", 0.0);
+        sequencer.addVoiceFromNow(voice, note.getTime() * secondsPerBeat,
+                                  note.getDuration() * secondsPerBeat);
+    }
+    std::chrono::duration<double, std::micro> elapsed = Clock::now() - start;
+    report.add("schedule.score", "us", elapsed.count());
+
+    // The same notes as one NoteScheduler batch
+    PolySynth synth;
+    synth.allocatePolyphony<SineEnv>(score->getNotes()->size());
+    NoteScheduler scheduler;
+    std::vector<NoteEvent> events;
+    NoteScheduler::fromSequence(*score, TempoMap(kSampleRate, BPM), events);
+    // Hand over the whole score at once, voices and all, as the sequencer does
+    for (const NoteEvent &e : events) {
+        scheduler.horizon = std::max(scheduler.horizon, e.frame + 1);
+    }
+    start = Clock::now();
+    scheduler.schedule<SineEnv>(synth, events);
+    elapsed = Clock::now() - start;
+    delete score;
+
+    report.add("schedule.bulk", "us", elapsed.count());
+}
+
+// Panning into 2 to 64 channels: the gain-ramp kernel alone, SIMD against
+// scalar, then 64 SineEnv voices spread over a speaker ring.
+void benchSpatial()
+{
+    const int numBlocks = 2000;
+    std::vector<float> in(kBlockSize), out(kBlockSize);
+    for (int i = 0; i < kBlockSize; i++) {
+        in[i] = (i % 100) * 0.01f - 0.5f;
+    }
+
+    for (int channels = 2; channels <= 64; channels *= 2) {
+        auto layout = std::make_shared<SpeakerLayout>(SpeakerLayout::ring(channels));
+
+        for (int simd = 0; simd <= 1; simd++) {
+            auto start = Clock::now();
+            for (int b = 0; b < numBlocks; b++) {
+                for (int c = 0; c < channels; c++) {
+                    if (simd) {
+                        Spatializer::mixRamp(in.data(), out.data(), kBlockSize, 0.5f, 1e-5f);
+                    } else {
+                        Spatializer::mixRampScalar(in.data(), out.data(), kBlockSize, 0.5f, 1e-5f);
+                    }
+                }
+            }
+            std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+            report.add("spatial.mix" + std::string(simd ? ".simd." : ".scalar.") + std::to_string(channels),
+                       "ns/channel-sample", elapsed.count() / ((double)numBlocks * channels * kBlockSize));
+        }
+
+        SpeakerLayout::current(layout);
+        double ns = timeVoices<SineEnv>(64, 200, [](SineEnv &voice, int v) {
+            voice.setInternalParameterValue("pan", v / 32.f - 1.f);
+        }, channels);
+        report.add("spatial.SineEnv." + std::to_string(channels), "ns/voice-sample", ns);
+    }
+    SpeakerLayout::current(nullptr);
+}
+
+// A burst of OSC messages through the loopback interface, timed from
+// send to the receive thread's handler.
+void benchOsc()
+{
+    const int numMessages = 1000;
+    const unsigned short port = 16448;
+
+    struct Handler : public osc::PacketHandler {
+        std::vector<Clock::time_point> received;
+        std::atomic<int> count{0};
+        void onMessage(osc::Message &m) override {
+            int index;
+            m >> index;
+            if (index >= 0 && index < (int)received.size()) {
+                received[index] = Clock::now();
+            }
+            count++;
+        }
+    } handler;
+    handler.received.resize(numMessages);
+    std::vector<Clock::time_point> sent(numMessages);
+
+    osc::Recv server;
+    if (!server.open(port, "localhost", 0.001)) {
+        printf("osc: can't open port %d, skipped\n", port);
+        return;
+    }
+    server.handler(handler);
+    server.start();
+    osc::Send client;
+    client.open(port, "localhost");
+
+    for (int i = 0; i < numMessages; i++) {
+        sent[i] = Clock::now();
+        client.send("/bench", i);
+    }
+    auto deadline = Clock::now() + std::chrono::seconds(2);
+    while (handler.count < numMessages && Clock::now() < deadline) {
+        al::wait(0.001);
+    }
+    server.stop();
+
+    double sum = 0;
+    int received = 0;
+    for (int i = 0; i < numMessages; i++) {
+        if (handler.received[i] > sent[i]) {
+            sum += std::chrono::duration<double, std::micro>(handler.received[i] - sent[i]).count();
+            received++;
+        }
+    }
+    if (received > 0) {
+        report.add("osc.latency", "us", sum / received);
+    }
+    if (received < numMessages) {
+        printf("osc: %d of %d messages lost\n", numMessages - received, numMessages);
+    }
+}
+
+// The SineBank kernel against one gam::Sine per partial, and how many
+// partials one core could keep up with in real time; then whole
+// AdditiveEnv voices at a few partial counts
+void benchAdditive()
+{
+    const int numPartials = SineBank::kMaxPartials;
+    const int numBlocks = 2000;
+    std::vector<float> out(kBlockSize);
+
+    for (int simd = 0; simd <= 1; simd++) {
+        SineBank bank;
+        for (int k = 1; k <= numPartials; k++) {
+            bank.add(55.f * k, 1.f / numPartials, 0, kSampleRate);
+        }
+        auto start = Clock::now();
+        for (int b = 0; b < numBlocks; b++) {
+            if (simd) {
+                bank.render(out.data(), kBlockSize);
+            } else {
+                bank.renderScalar(out.data(), kBlockSize);
+            }
+        }
+        std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+        const double ns = elapsed.count() / ((double)numBlocks * kBlockSize * numPartials);
+        report.add(std::string("additive.bank.") + (simd ? "simd" : "scalar"), "ns/partial-sample", ns);
+        if (simd) {
+            report.add("additive.partials-per-core", "partials", 1e9 / (ns * kSampleRate), true);
+        }
+    }
+
+    std::vector<gam::Sine<>> sines(numPartials);
+    for (int k = 0; k < numPartials; k++) {
+        sines[k].freq(55.f * (k + 1));
+    }
+    auto start = Clock::now();
+    for (int b = 0; b < numBlocks; b++) {
+        for (auto &sine : sines) {
+            for (int i = 0; i < kBlockSize; i++) {
+                out[i] += sine() * (1.f / numPartials);
+            }
+        }
+    }
+    std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+    report.add("additive.gam-sine", "ns/partial-sample",
+               elapsed.count() / ((double)numBlocks * kBlockSize * numPartials));
+
+    for (int partials = 8; partials <= numPartials; partials *= 2) {
+        double ns = timeVoices<AdditiveEnv>(64, 200, [&](AdditiveEnv &voice, int) {
+            voice.setInternalParameterValue("partials", partials);
+        });
+        report.add("additive.AdditiveEnv." + std::to_string(partials), "ns/voice-sample", ns);
+    }
+}
+
+struct Benchmark {
+    const char *name;
+    void (*run)();
+};
+
+const Benchmark benchmarks[] = {
+    {"wavetable", benchWavetable},
+    {"chord", benchChord},
+    {"score", benchScore},
+    {"parallel", benchParallel},
+    {"schedule", benchSchedule},
+    {"packed", benchPacked},
+    {"osc", benchOsc},
+    {"spatial", benchSpatial},
+    {"additive", benchAdditive},
+};
+
+int main(int argc, char *argv[])
+{
+    gam::sampleRate(kSampleRate);
+
+    int repeat = 5;
+    double tolerance = 0.05;
+    double sigmas = 3.0;
+    std::string jsonPath, baselinePath;
+    std::vector<std::string> names;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+            repeat = std::max(1, atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            jsonPath = argv[++i];
+        } else if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+            baselinePath = argv[++i];
+        } else if (strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc) {
+            tolerance = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--sigmas") == 0 && i + 1 < argc) {
+            sigmas = atof(argv[++i]);
+        } else {
+            names.push_back(argv[i]);
+        }
+    }
+
+    const std::string machine = BenchmarkReport::machine();
+    printf("revision %s on %s, %d runs each\n", GIT_REVISION, machine.c_str(), repeat);
+    for (auto &b : benchmarks) {
+        bool selected = names.empty();
+        for (auto &name : names) {
+            if (name == b.name) {
+                selected = true;
+            }
+        }
+        if (!selected) {
+            continue;
+        }
+        for (int r = 0; r < repeat; r++) {
+            b.run();
+        }
+    }
+    report.print();
+
+    if (!jsonPath.empty() && !report.save(jsonPath, GIT_REVISION, machine)) {
+        printf("can't write %s\n", jsonPath.c_str());
+        return 2;
+    }
+    if (!baselinePath.empty()) {
+        printf("compared with %s:\n", baselinePath.c_str());
+        int regressions = report.compare(baselinePath, tolerance, sigmas);
+        if (regressions < 0) {
+            printf("can't read %s\n", baselinePath.c_str());
+            return 2;
+        }
+        if (regressions > 0) {
+            printf("%d regression(s)\n", regressions);
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,155 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+
+#include <unistd.h>
+
+#include "BenchmarkReport.hpp"
+
+double BenchmarkMetric::median() const
+{
+    if (samples.empty()) {
+        return 0;
+    }
+    std::vector<double> s = samples;
+    std::sort(s.begin(), s.end());
+    const size_t n = s.size();
+    return n % 2 ? s[n / 2] : 0.5 * (s[n / 2 - 1] + s[n / 2]);
+}
+
+double BenchmarkMetric::mean() const
+{
+    double sum = 0;
+    for (double v : samples) {
+        sum += v;
+    }
+    return samples.empty() ? 0 : sum / samples.size();
+}
+
+double BenchmarkMetric::stddev() const
+{
+    if (samples.size() < 2) {
+        return 0;
+    }
+    const double m = mean();
+    double sum = 0;
+    for (double v : samples) {
+        sum += (v - m) * (v - m);
+    }
+    return std::sqrt(sum / (samples.size() - 1));
+}
+
+void BenchmarkReport::add(const std::string &name, const std::string &unit, double value,
+                          bool higherIsBetter)
+{
+    auto it = mMetrics.find(name);
+    if (it == mMetrics.end()) {
+        mOrder.push_back(name);
+        it = mMetrics.emplace(name, BenchmarkMetric()).first;
+        it->second.unit = unit;
+        it->second.higherIsBetter = higherIsBetter;
+    }
+    it->second.samples.push_back(value);
+}
+
+void BenchmarkReport::print() const
+{
+    for (const std::string &name : mOrder) {
+        const BenchmarkMetric &m = mMetrics.at(name);
+        printf("  %-36s %12.3f %-16s +/- %.3f (n=%d)\n", name.c_str(), m.median(),
+               m.unit.c_str(), m.stddev(), (int)m.samples.size());
+    }
+}
+
+bool BenchmarkReport::save(const std::string &path, const std::string &revision,
+                           const std::string &machine) const
+{
+    FILE *f = fopen(path.c_str(), "w");
+    if (!f) {
+        return false;
+    }
+    char date[32];
+    time_t now = time(nullptr);
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+
+    // One metric per line, which is all compare() relies on when reading
+    fprintf(f, "{\n  \"revision\": \"%s\",\n  \"machine\": \"%s\",\n  \"date\": \"%s\",\n",
+            revision.c_str(), machine.c_str(), date);
+    fprintf(f, "  \"metrics\": {\n");
+    for (size_t i = 0; i < mOrder.size(); i++) {
+        const BenchmarkMetric &m = mMetrics.at(mOrder[i]);
+        fprintf(f, "    \"%s\": {\"unit\": \"%s\", \"median\": %.6g, \"mean\": %.6g, \"stddev\": %.6g, \"samples\": [",
+                mOrder[i].c_str(), m.unit.c_str(), m.median(), m.mean(), m.stddev());
+        for (size_t k = 0; k < m.samples.size(); k++) {
+            fprintf(f, "%s%.6g", k ? ", " : "", m.samples[k]);
+        }
+        fprintf(f, "]}%s\n", i + 1 < mOrder.size() ? "," : "");
+    }
+    fprintf(f, "  }\n}\n");
+    return fclose(f) == 0;
+}
+
+int BenchmarkReport::compare(const std::string &baselinePath, double tolerance, double sigmas) const
+{
+    std::ifstream in(baselinePath);
+    if (!in) {
+        return -1;
+    }
+
+    int regressions = 0;
+    std::string line;
+    while (std::getline(in, line)) {
+        const char *s = line.c_str();
+        const char *open = strchr(s, '"');
+        const char *close = open ? strchr(open + 1, '"') : nullptr;
+        const char *median = strstr(s, "\"median\":");
+        const char *stddev = strstr(s, "\"stddev\":");
+        if (!close || !median || !stddev) {
+            continue;
+        }
+        const std::string name(open + 1, close);
+        auto it = mMetrics.find(name);
+        if (it == mMetrics.end()) {
+            continue;
+        }
+
+        const double baseMedian = atof(median + 9);
+        const double baseStddev = atof(stddev + 9);
+        const double current = it->second.median();
+        const double noise = sigmas * std::max(baseStddev, it->second.stddev());
+        const double change = baseMedian > 0 ? (current - baseMedian) / baseMedian : 0;
+        // How much worse, in the metric's own direction
+        const double sign = it->second.higherIsBetter ? -1 : 1;
+        const bool regressed = sign * change > tolerance && sign * (current - baseMedian) > noise;
+        if (regressed) {
+            regressions++;
+        }
+        printf("  %-36s %12.3f -> %12.3f %-16s %+6.1f%% %s\n", name.c_str(), baseMedian, current,
+               it->second.unit.c_str(), change * 100, regressed ? "REGRESSION" : "ok");
+    }
+    return regressions;
+}
+
+std::string BenchmarkReport::machine()
+{
+    char host[256] = "unknown";
+    gethostname(host, sizeof(host) - 1);
+
+    std::string cpu = "unknown cpu";
+    std::ifstream info("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(info, line)) {
+        if (line.compare(0, 10, "model name") == 0) {
+            size_t colon = line.find(':');
+            if (colon != std::string::npos) {
+                cpu = line.substr(line.find_first_not_of(' ', colon + 1));
+            }
+            break;
+        }
+    }
+    return std::string(host) + " (" + cpu + ")";
+}
@@ -0,0 +1,47 @@
+#ifndef BENCHMARKREPORT_HPP
+#define BENCHMARKREPORT_HPP
+
+#include <map>
+#include <string>
+#include <vector>
+
+// Repeated measurements of one benchmark metric. Lower is better unless
+// higherIsBetter is set (throughputs and capacities).
+struct BenchmarkMetric {
+    std::string unit;
+    bool higherIsBetter = false;
+    std::vector<double> samples;
+
+    double median() const;
+    double mean() const;
+    double stddev() const;
+};
+
+// Collects metrics over repeated runs, saves them as JSON tagged with
+// the git revision and machine, and compares them against a saved
+// baseline to catch regressions.
+class BenchmarkReport {
+    public:
+        void add(const std::string &name, const std::string &unit, double value,
+                 bool higherIsBetter = false);
+
+        void print() const;
+        bool save(const std::string &path, const std::string &revision,
+                  const std::string &machine) const;
+
+        // A metric regresses when its median is worse than the baseline
+        // median by more than `tolerance` (relative) and by more than
+        // `sigmas` times the larger of the two standard deviations, so
+        // that noisy metrics need a bigger change to fail. Returns the
+        // number of regressions, or -1 if the baseline can't be read.
+        int compare(const std::string &baselinePath, double tolerance, double sigmas) const;
+
+        // Host name and CPU model, as recorded in saved reports
+        static std::string machine();
+
+    private:
+        std::vector<std::string> mOrder;
+        std::map<std::string, BenchmarkMetric> mMetrics;
+};
+
+#endif
@@ -0,0 +1,73 @@
+#include <algorithm>
+#include <cmath>
+
+#include "LatencyProbe.hpp"
+
+void LatencyProbe::start()
+{
+    mFrame = 0;
+    mNextEmit = 0;
+    mWaiting = false;
+    mCount = 0;
+    mMissed = 0;
+    mSum = 0;
+    mMin = UINT64_MAX;
+    mMax = 0;
+    mDone = false;
+    mRunning = true;
+}
+
+void LatencyProbe::process(AudioIOData &io)
+{
+    if (!mRunning || io.channelsIn() < 1 || io.channelsOut() < 1) {
+        return;
+    }
+    mSampleRate = io.framesPerSecond();
+    const uint64_t gap = (uint64_t)(gapSeconds * mSampleRate);
+    const uint64_t timeout = (uint64_t)(timeoutSeconds * mSampleRate);
+    const float *in = io.inBuffer(0);
+    float *out = io.outBuffer(0);
+
+    const int frames = io.framesPerBuffer();
+    for (int i = 0; i < frames; i++) {
+        const uint64_t now = mFrame + i;
+        if (mWaiting) {
+            if (std::fabs(in[i]) > threshold) {
+                const uint64_t latency = now - mEmitted;
+                mSum += latency;
+                mMin = std::min(mMin, latency);
+                mMax = std::max(mMax, latency);
+                mCount++;
+                mWaiting = false;
+                mNextEmit = now + gap;
+            } else if (now - mEmitted > timeout) {
+                mMissed++;
+                mWaiting = false;
+                mNextEmit = now + gap;
+            }
+        } else if (now >= mNextEmit) {
+            if (mCount + mMissed >= repeats) {
+                mRunning = false;
+                mDone = true;
+                break;
+            }
+            out[i] = 1.f;
+            mEmitted = now;
+            mWaiting = true;
+        }
+    }
+    mFrame += frames;
+}
+
+bool LatencyProbe::finished(double &minMs, double &meanMs, double &maxMs, int &missed)
+{
+    if (!mDone.exchange(false)) {
+        return false;
+    }
+    const double msPerFrame = 1000.0 / mSampleRate;
+    minMs = mCount ? mMin * msPerFrame : 0;
+    meanMs = mCount ? (double)mSum / mCount * msPerFrame : 0;
+    maxMs = mCount ? mMax * msPerFrame : 0;
+    missed = mMissed;
+    return true;
+}
@@ -0,0 +1,44 @@
+#ifndef LATENCYPROBE_HPP
+#define LATENCYPROBE_HPP
+
+#include <atomic>
+#include <cstdint>
+
+#include "al/io/al_AudioIOData.hpp"
+
+using namespace al;
+
+// Measures round-trip input-to-output latency through a loopback cable
+// from output channel 0 to input channel 0. An impulse is written to the
+// output, and the frames until it shows up on the input are counted.
+// process() runs on the audio thread after the synth has rendered.
+class LatencyProbe {
+    public:
+        int repeats = 8;          // impulses to average over
+        float threshold = 0.25f;  // input level that counts as the impulse
+        double gapSeconds = 0.25; // silence between impulses
+        double timeoutSeconds = 1.0;
+
+        void start();
+        bool running() const { return mRunning; }
+
+        void process(AudioIOData &io);
+
+        // Returns true once after all repeats completed; times are in ms.
+        // missed counts impulses that never came back within the timeout.
+        bool finished(double &minMs, double &meanMs, double &maxMs, int &missed);
+
+    private:
+        uint64_t mFrame = 0;
+        uint64_t mEmitted = 0;
+        uint64_t mNextEmit = 0;
+        bool mWaiting = false;
+        int mCount = 0;
+        int mMissed = 0;
+        uint64_t mSum = 0, mMin = 0, mMax = 0;
+        double mSampleRate = 0;
+        std::atomic<bool> mRunning{false};
+        std::atomic<bool> mDone{false};
+};
+
+#endif
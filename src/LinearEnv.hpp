@@ -0,0 +1,113 @@
+#ifndef LINEARENV_HPP
+#define LINEARENV_HPP
+
+#include <algorithm>
+#include <cmath>
+
+// Envelope of N straight-line segments between N + 1 levels, with an
+// optional sustain point, evaluated a block at a time. Within a segment
+// every sample is start + step * i, so process() fills whole runs without
+// per-sample stage checks and the inner loop vectorizes. Segment ends and
+// the sustain point falling inside a block just split the run.
+//
+// The interface follows gam::Env with curve(0): levels(), lengths() in
+// seconds, sustainPoint(), reset(), release() and done().
+template <int N>
+class LinearEnv {
+    public:
+        LinearEnv() {
+            std::fill(mLevels, mLevels + N + 1, 0.f);
+            std::fill(mLengths, mLengths + N, 0.f);
+        }
+
+        void sampleRate(double sr) { mSampleRate = (float)sr; }
+
+        template <class... Levels>
+        LinearEnv &levels(Levels... values) {
+            static_assert(sizeof...(values) == N + 1, "LinearEnv needs N + 1 levels");
+            const float v[] = {(float)values...};
+            std::copy(v, v + N + 1, mLevels);
+            return *this;
+        }
+        float *levels() { return mLevels; }
+        // Segment lengths in seconds; may be changed while running
+        float *lengths() { return mLengths; }
+
+        // Hold at level point p until release(); N disables sustain
+        LinearEnv &sustainPoint(int p) { mSustain = p; return *this; }
+
+        void reset() { startSegment(0, mLevels[0]); mReleased = false; }
+
+        // Jump to the segment after the sustain point, from the current value
+        void release() {
+            mReleased = true;
+            if (mSustain < N && mStage <= mSustain) {
+                startSegment(mSustain, mValue);
+            }
+        }
+
+        bool done() const { return mStage >= N; }
+        bool sustained() const { return mStage == mSustain && !mReleased; }
+        float value() const { return mValue; }
+
+        // Fill out[0..n) and advance by n samples.
+        void process(float *out, int n) {
+            int i = 0;
+            while (i < n) {
+                if (done() || sustained()) {
+                    std::fill(out + i, out + n, mValue);
+                    return;
+                }
+                const float length = mLengths[mStage] * mSampleRate;
+                const float remaining = length - mPos;
+                if (remaining <= 0.f) {
+                    nextSegment();
+                    continue;
+                }
+                const float step = (mLevels[mStage + 1] - mStart) / length;
+                const float base = mStart + step * mPos;
+                const int count = std::min(n - i, (int)std::ceil(remaining));
+                float *o = out + i;
+                for (int k = 0; k < count; k++) {
+                    o[k] = base + step * k;
+                }
+                mPos += count;
+                mValue = o[count - 1];
+                i += count;
+                if (mPos >= length) {
+                    nextSegment();
+                }
+            }
+        }
+
+        // Single-sample form, for code that still runs per sample
+        float operator()() {
+            float v;
+            process(&v, 1);
+            return v;
+        }
+
+    private:
+        void startSegment(int stage, float from) {
+            mStage = stage;
+            mStart = from;
+            mValue = from;
+            mPos = 0.f;
+        }
+
+        void nextSegment() {
+            startSegment(mStage + 1, mLevels[mStage + 1]);
+        }
+
+        float mLevels[N + 1];
+        float mLengths[N];
+        float mSampleRate = 44100.f;
+        int mSustain = N;
+        int mStage = N;      // done until reset()
+        bool mReleased = false;
+        float mStart = 0.f;  // value at the start of the current segment
+        float mPos = 0.f;    // samples into the current segment
+        float mValue = 0.f;  // last value output
+};
+
+#endif
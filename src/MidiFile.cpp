@@ -0,0 +1,336 @@
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "MidiFile.hpp"
+
+namespace {
+    uint32_t bigEndian(const unsigned char *p, int n)
+    {
+        uint32_t v = 0;
+        for (int i = 0; i < n; i++) {
+            v = (v << 8) | p[i];
+        }
+        return v;
+    }
+}
+
+bool MidiFile::open(const std::string &path)
+{
+    close();
+    mFile = fopen(path.c_str(), "rb");
+    if (!mFile) {
+        return false;
+    }
+
+    unsigned char header[14];
+    if (fread(header, 1, 14, mFile) != 14 || memcmp(header, "MThd", 4) != 0) {
+        close();
+        return false;
+    }
+    const uint32_t headerLength = bigEndian(header + 4, 4);
+    mFormat = bigEndian(header + 8, 2);
+    const int numTracks = bigEndian(header + 10, 2);
+    const int division = bigEndian(header + 12, 2);
+    if (mFormat > 1 || headerLength < 6) {
+        // Format 2 tracks are independent patterns, not one piece
+        close();
+        return false;
+    }
+    if (division & 0x8000) {
+        // SMPTE: frames per second (negated) and ticks per frame
+        const int fps = -(int8_t)(division >> 8);
+        mSmpteTicksPerSecond = (fps == 29 ? 29.97 : fps) * (division & 0xff);
+    } else {
+        mDivision = division;
+        mSmpteTicksPerSecond = 0;
+    }
+
+    // Find the track chunks without reading them
+    long offset = 8 + headerLength;
+    mTracks.clear();
+    while ((int)mTracks.size() < numTracks) {
+        unsigned char chunk[8];
+        if (fseek(mFile, offset, SEEK_SET) != 0 || fread(chunk, 1, 8, mFile) != 8) {
+            break;
+        }
+        const uint32_t length = bigEndian(chunk + 4, 4);
+        if (memcmp(chunk, "MTrk", 4) == 0) {
+            mTracks.emplace_back();
+            mTracks.back().offset = offset + 8;
+            mTracks.back().end = offset + 8 + length;
+        }
+        offset += 8 + length;
+    }
+    if (mTracks.empty()) {
+        close();
+        return false;
+    }
+
+    mTempoTick = 0;
+    mTempoSeconds = 0;
+    mLastTick = 0;
+    mSecondsPerTick = mSmpteTicksPerSecond > 0 ? 1.0 / mSmpteTicksPerSecond : 0.5 / mDivision;
+    mHeld.assign(16 * 128, std::vector<HeldNote>());
+    mReady.clear();
+    mPosition = 0;
+    mFinished = false;
+    for (Track &t : mTracks) {
+        advance(t);
+    }
+    return true;
+}
+
+void MidiFile::close()
+{
+    if (mFile) {
+        fclose(mFile);
+        mFile = nullptr;
+    }
+    mTracks.clear();
+    mHeld.clear();
+    mReady.clear();
+    mFinished = true;
+}
+
+bool MidiFile::readUntil(float untilBeat, Sequence &out)
+{
+    // Every event up to untilBeat
+    while (!mFinished) {
+        Track *next = nextTrack();
+        if (next && beat(seconds(next->tick)) > untilBeat) {
+            mPosition = std::max(mPosition, untilBeat);
+            break;
+        }
+        decode(next);
+    }
+    // Then on until the notes started by untilBeat have all been released
+    for (float held = earliestHeld(); !mFinished && held <= untilBeat;) {
+        mReleased = false;
+        decode(nextTrack());
+        if (mReleased) {
+            held = earliestHeld();
+        }
+    }
+
+    std::vector<Note> later;
+    for (const Note &note : mReady) {
+        if (note.getTime() <= untilBeat) {
+            out.add(note);
+        } else {
+            later.push_back(note);
+        }
+    }
+    mReady.swap(later);
+    return !finished();
+}
+
+MidiFile::Track *MidiFile::nextTrack()
+{
+    // The track whose next event comes first; ties go to the lower track,
+    // so tempo changes in track 0 apply to notes at that tick
+    Track *next = nullptr;
+    for (Track &t : mTracks) {
+        if (!t.done && (!next || t.tick < next->tick)) {
+            next = &t;
+        }
+    }
+    return next;
+}
+
+void MidiFile::decode(Track *next)
+{
+    if (!next) {
+        // End of file: close notes that were never released
+        const double end = seconds(mLastTick);
+        for (int k = 0; k < (int)mHeld.size(); k++) {
+            while (!mHeld[k].empty()) {
+                noteOff(k / 128, k % 128, end);
+            }
+        }
+        mFinished = true;
+        return;
+    }
+    mPosition = beat(seconds(next->tick));
+    mLastTick = next->tick;
+    decodeEvent(*next);
+    advance(*next);
+}
+
+float MidiFile::earliestHeld() const
+{
+    double earliest = std::numeric_limits<double>::max();
+    for (const std::vector<HeldNote> &held : mHeld) {
+        if (!held.empty()) {
+            earliest = std::min(earliest, held.front().seconds);
+        }
+    }
+    return earliest == std::numeric_limits<double>::max() ? std::numeric_limits<float>::max()
+                                                          : beat(earliest);
+}
+
+Sequence *MidiFile::load(const std::string &path, float bpm)
+{
+    MidiFile file(bpm);
+    if (!file.open(path)) {
+        return nullptr;
+    }
+    TimeSignature t;
+    Sequence *result = new Sequence(t);
+    file.readUntil(std::numeric_limits<float>::max(), *result);
+    return result;
+}
+
+bool MidiFile::readByte(Track &t, unsigned char &b)
+{
+    if (t.pos == t.length) {
+        const long left = t.end - t.offset;
+        if (left <= 0) {
+            return false;
+        }
+        const int n = left < kBufferSize ? left : kBufferSize;
+        if (fseek(mFile, t.offset, SEEK_SET) != 0) {
+            return false;
+        }
+        t.length = fread(t.buffer, 1, n, mFile);
+        t.pos = 0;
+        t.offset += t.length;
+        if (t.length <= 0) {
+            return false;
+        }
+    }
+    b = t.buffer[t.pos++];
+    return true;
+}
+
+bool MidiFile::readVarLen(Track &t, uint32_t &value)
+{
+    value = 0;
+    for (int i = 0; i < 4; i++) {
+        unsigned char b;
+        if (!readByte(t, b)) {
+            return false;
+        }
+        value = (value << 7) | (b & 0x7f);
+        if (!(b & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool MidiFile::skip(Track &t, uint32_t n)
+{
+    // Within the buffer, or past it without reading what's skipped
+    const uint32_t buffered = t.length - t.pos;
+    if (n <= buffered) {
+        t.pos += n;
+        return true;
+    }
+    t.offset += n - buffered;
+    t.pos = t.length = 0;
+    return t.offset <= t.end;
+}
+
+void MidiFile::advance(Track &t)
+{
+    uint32_t delta;
+    if (t.done || !readVarLen(t, delta)) {
+        t.done = true;
+        return;
+    }
+    t.tick += delta;
+}
+
+void MidiFile::decodeEvent(Track &t)
+{
+    unsigned char b;
+    if (!readByte(t, b)) {
+        t.done = true;
+        return;
+    }
+    uint32_t length;
+    if (b == 0xff) {
+        unsigned char type;
+        if (!readByte(t, type) || !readVarLen(t, length)) {
+            t.done = true;
+            return;
+        }
+        if (type == 0x2f) {
+            t.done = true;
+        } else if (type == 0x51 && length == 3 && mSmpteTicksPerSecond == 0) {
+            unsigned char tempo[3];
+            for (int i = 0; i < 3; i++) {
+                readByte(t, tempo[i]);
+            }
+            // Start a new tempo map segment at this tick
+            mTempoSeconds = seconds(t.tick);
+            mTempoTick = t.tick;
+            mSecondsPerTick = bigEndian(tempo, 3) * 1e-6 / mDivision;
+        } else {
+            skip(t, length);
+        }
+        return;
+    }
+    if (b == 0xf0 || b == 0xf7) {
+        // System exclusive; cancels running status
+        t.status = 0;
+        if (!readVarLen(t, length) || !skip(t, length)) {
+            t.done = true;
+        }
+        return;
+    }
+
+    unsigned char data[2] = {0, 0};
+    int next = 0;
+    if (b & 0x80) {
+        t.status = b;
+    } else if (t.status) {
+        // Running status: b is already the first data byte
+        data[next++] = b;
+    } else {
+        t.done = true; // corrupt track
+        return;
+    }
+    const int kind = t.status & 0xf0;
+    const int count = (kind == 0xc0 || kind == 0xd0) ? 1 : 2;
+    for (; next < count; next++) {
+        if (!readByte(t, data[next])) {
+            t.done = true;
+            return;
+        }
+    }
+
+    const int channel = t.status & 0x0f;
+    const double at = seconds(t.tick);
+    if (kind == 0x90 && data[1] > 0) {
+        noteOn(channel, data[0] & 0x7f, data[1], at);
+    } else if (kind == 0x80 || kind == 0x90) {
+        noteOff(channel, data[0] & 0x7f, at);
+    }
+}
+
+double MidiFile::seconds(uint64_t tick) const
+{
+    return mTempoSeconds + (double)(tick - mTempoTick) * mSecondsPerTick;
+}
+
+void MidiFile::noteOn(int channel, int key, int velocity, double at)
+{
+    mHeld[channel * 128 + key].push_back({at, velocity});
+}
+
+void MidiFile::noteOff(int channel, int key, double at)
+{
+    std::vector<HeldNote> &held = mHeld[channel * 128 + key];
+    if (held.empty()) {
+        return;
+    }
+    const HeldNote note = held.front();
+    held.erase(held.begin());
+
+    const float v = note.velocity / 127.f;
+    const float start = beat(note.seconds);
+    mReady.push_back(Note(tuning->freq(key), start, beat(at) - start, maxAmp * v * v));
+    mReleased = true;
+}
@@ -0,0 +1,110 @@
+#ifndef MIDIFILE_HPP
+#define MIDIFILE_HPP
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "Sequence.hpp"
+#include "Tuning.hpp"
+
+// Streaming reader for Standard MIDI Files (formats 0 and 1). open() only
+// reads the header and finds the track chunks; events are decoded as
+// readUntil() advances, through a small buffer per track, so a large
+// multitrack file starts at once and memory doesn't grow with its length.
+//
+// Tracks are merged in tick order and converted through the tempo map,
+// so note times come out in beats at `bpm`: playing the Sequence at that
+// tempo reproduces the file's own timing, tempo changes included. Note-on
+// and note-off pairs become one Note (overlapping notes on the same key
+// pair first-in first-out); velocity maps to amplitude as
+// maxAmp * (velocity / 127)^2.
+//
+// A note is handed out by the readUntil() call whose window it starts in,
+// however long it is held: decoding runs past the window until every
+// note started in it has its note-off, and notes completed on the way
+// that start later wait for the call that reaches them. Memory grows only
+// with the notes that start while the longest note is held.
+class MidiFile {
+    public:
+        float maxAmp = 0.25f;                    // amplitude at velocity 127
+        const TuningTable *tuning = &kConcertPitch;
+
+        explicit MidiFile(float bpm = 77.f) : mBpm(bpm) {}
+        ~MidiFile() { close(); }
+
+        // Returns false if path isn't a MIDI file we can read
+        bool open(const std::string &path);
+        void close();
+
+        int format() const { return mFormat; }
+        int numTracks() const { return mTracks.size(); }
+
+        // Add every note starting at or before `beat` that earlier calls
+        // haven't, with its full duration. Returns false once the whole
+        // file has been handed out; notes still held at its end are closed
+        // there.
+        bool readUntil(float beat, Sequence &out);
+        bool finished() const { return mFinished && mReady.empty(); }
+        // Beat the file has been decoded up to
+        float position() const { return mPosition; }
+
+        // Convenience: the whole file as a new Sequence, nullptr on error
+        static Sequence *load(const std::string &path, float bpm = 77.f);
+
+    private:
+        static const int kBufferSize = 4096;
+
+        struct Track {
+            long offset = 0;      // file offset of the next unbuffered byte
+            long end = 0;         // end of the chunk
+            unsigned char buffer[kBufferSize];
+            int length = 0, pos = 0;
+            uint64_t tick = 0;    // absolute tick of the pending event
+            unsigned char status = 0;
+            bool done = false;
+        };
+
+        struct HeldNote {
+            double seconds;
+            int velocity;
+        };
+
+        bool readByte(Track &t, unsigned char &b);
+        bool readVarLen(Track &t, uint32_t &value);
+        bool skip(Track &t, uint32_t n);
+        // Read the delta time of the next event, or mark the track done
+        void advance(Track &t);
+        Track *nextTrack();
+        // Decode next's pending event, or close the file's held notes if
+        // next is null
+        void decode(Track *next);
+        void decodeEvent(Track &t);
+        float earliestHeld() const;
+        double seconds(uint64_t tick) const;
+        float beat(double seconds) const { return (float)(seconds * mBpm / 60.0); }
+        void noteOn(int channel, int key, int velocity, double at);
+        void noteOff(int channel, int key, double at);
+
+        FILE *mFile = nullptr;
+        float mBpm;
+        int mFormat = 0;
+        int mDivision = 480;                    // ticks per quarter note
+        double mSmpteTicksPerSecond = 0;        // set for SMPTE time division
+        std::vector<Track> mTracks;
+
+        // Tempo map position: the last tempo change seen
+        uint64_t mTempoTick = 0;
+        double mTempoSeconds = 0;
+        double mSecondsPerTick = 0.5 / 480;
+        uint64_t mLastTick = 0;                 // tick of the last event decoded
+
+        std::vector<std::vector<HeldNote>> mHeld; // by channel * 128 + key
+        std::vector<Note> mReady;   // complete, starting after the last window
+        bool mReleased = false;     // a note-off was decoded
+        float mPosition = 0;
+        bool mFinished = true;
+};
+
+#endif
@@ -0,0 +1,226 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include "MixGraph.hpp"
+
+void SoftClip::process(float *const *buffers, int channels, int frames)
+{
+    // Above the threshold t, u / (1 + u) of the overshoot u: unit slope at
+    // the knee, approaching 1 but never reaching it
+    const float t = threshold;
+    const float range = 1.f - t;
+    for (int c = 0; c < channels; c++) {
+        float *b = buffers[c];
+        for (int i = 0; i < frames; i++) {
+            const float x = b[i];
+            const float a = std::fabs(x);
+            if (a > t) {
+                const float u = (a - t) / range;
+                b[i] = std::copysign(t + range * u / (1.f + u), x);
+            }
+        }
+    }
+}
+
+MixGraph::MixGraph()
+{
+    mBuses.emplace_back(new Bus);
+    mBuses[kMaster]->name = "master";
+    updateOrder();
+}
+
+void MixGraph::configure(int channels, int maxFrames, double sampleRate)
+{
+    mChannels = channels;
+    mMaxFrames = maxFrames;
+    mFrames = maxFrames;
+    mScratch.framesPerSecond(sampleRate);
+    mScratch.framesPerBuffer(maxFrames);
+    mScratch.channels(channels, true);
+    allocate();
+}
+
+int MixGraph::addBus(const std::string &name, int output)
+{
+    mBuses.emplace_back(new Bus);
+    mBuses.back()->name = name;
+    mBuses.back()->output = output;
+    allocate();
+    updateOrder();
+    return mBuses.size() - 1;
+}
+
+bool MixGraph::route(int bus, int output)
+{
+    if (bus == kMaster || bus == output || feeds(output, bus)) {
+        return false;
+    }
+    mBuses[bus]->output = output;
+    updateOrder();
+    return true;
+}
+
+bool MixGraph::addSend(int bus, int target, float gain)
+{
+    if (bus == target || feeds(target, bus)) {
+        return false;
+    }
+    mBuses[bus]->sends.push_back({target, gain});
+    updateOrder();
+    return true;
+}
+
+void MixGraph::addEffect(int bus, std::shared_ptr<BusEffect> effect)
+{
+    mBuses[bus]->effects.push_back(std::move(effect));
+}
+
+int MixGraph::find(const std::string &name) const
+{
+    for (size_t i = 0; i < mBuses.size(); i++) {
+        if (mBuses[i]->name == name) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void MixGraph::beginBlock(int frames)
+{
+    mFrames = std::min(frames, mMaxFrames);
+    std::fill(mSlab.begin(), mSlab.end(), 0.f);
+}
+
+void MixGraph::accumulate(int bus, const AudioIOData &io)
+{
+    const int channels = std::min(mChannels, io.channelsOut());
+    for (int c = 0; c < channels; c++) {
+        const float *src = io.outBuffer(c);
+        float *dst = mBuses[bus]->channels[c];
+        for (int i = 0; i < mFrames; i++) {
+            dst[i] += src[i];
+        }
+    }
+}
+
+void MixGraph::process(AudioIOData &io)
+{
+    const int frames = std::min(mFrames, (int)io.framesPerBuffer());
+    for (int b : mOrder) {
+        Bus &bus = *mBuses[b];
+        for (auto &effect : bus.effects) {
+            effect->process(bus.channels.data(), mChannels, frames);
+        }
+
+        // Ramp from last block's gain to avoid zipper noise
+        const float g0 = bus.lastGain;
+        const float g1 = bus.gain.load(std::memory_order_relaxed);
+        bus.lastGain = g1;
+        if (g0 != 1.f || g1 != 1.f) {
+            const float step = (g1 - g0) / frames;
+            for (int c = 0; c < mChannels; c++) {
+                float *x = bus.channels[c];
+                for (int i = 0; i < frames; i++) {
+                    x[i] *= g0 + step * i;
+                }
+            }
+        }
+
+        if (b == kMaster) {
+            const int channels = std::min(mChannels, io.channelsOut());
+            for (int c = 0; c < channels; c++) {
+                const float *src = bus.channels[c];
+                float *dst = io.outBuffer(c);
+                for (int i = 0; i < frames; i++) {
+                    dst[i] += src[i];
+                }
+            }
+            continue;
+        }
+        for (int c = 0; c < mChannels; c++) {
+            const float *src = bus.channels[c];
+            if (bus.output >= 0) {
+                float *dst = mBuses[bus.output]->channels[c];
+                for (int i = 0; i < frames; i++) {
+                    dst[i] += src[i];
+                }
+            }
+            for (const Send &send : bus.sends) {
+                float *dst = mBuses[send.target]->channels[c];
+                for (int i = 0; i < frames; i++) {
+                    dst[i] += src[i] * send.gain;
+                }
+            }
+        }
+    }
+}
+
+void MixGraph::allocate()
+{
+    if (mMaxFrames <= 0) {
+        return;
+    }
+    const int floatsPerLine = kAlignment / sizeof(float);
+    mStride = (mMaxFrames + floatsPerLine - 1) / floatsPerLine * floatsPerLine;
+    mSlab.assign(mBuses.size() * mChannels * mStride + floatsPerLine, 0.f);
+
+    float *base = mSlab.data();
+    base += (floatsPerLine - ((uintptr_t)base / sizeof(float)) % floatsPerLine) % floatsPerLine;
+    for (auto &bus : mBuses) {
+        bus->channels.resize(mChannels);
+        for (int c = 0; c < mChannels; c++, base += mStride) {
+            bus->channels[c] = base;
+        }
+    }
+}
+
+bool MixGraph::feeds(int from, int to) const
+{
+    if (from == to) {
+        return true;
+    }
+    const Bus &bus = *mBuses[from];
+    if (bus.output >= 0 && feeds(bus.output, to)) {
+        return true;
+    }
+    for (const Send &send : bus.sends) {
+        if (feeds(send.target, to)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void MixGraph::updateOrder()
+{
+    // Kahn's algorithm over output and send edges
+    const int n = mBuses.size();
+    std::vector<int> inputs(n, 0);
+    for (auto &bus : mBuses) {
+        if (bus->output >= 0) {
+            inputs[bus->output]++;
+        }
+        for (const Send &send : bus->sends) {
+            inputs[send.target]++;
+        }
+    }
+
+    mOrder.clear();
+    for (int b = 0; b < n; b++) {
+        if (inputs[b] == 0) {
+            mOrder.push_back(b);
+        }
+    }
+    for (size_t k = 0; k < mOrder.size(); k++) {
+        const Bus &bus = *mBuses[mOrder[k]];
+        if (bus.output >= 0 && --inputs[bus.output] == 0) {
+            mOrder.push_back(bus.output);
+        }
+        for (const Send &send : bus.sends) {
+            if (--inputs[send.target] == 0) {
+                mOrder.push_back(send.target);
+            }
+        }
+    }
+}
@@ -0,0 +1,115 @@
+#ifndef MIXGRAPH_HPP
+#define MIXGRAPH_HPP
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "al/io/al_AudioIOData.hpp"
+
+using namespace al;
+
+// In-place processor attached to a bus. buffers[c] holds frames samples
+// of channel c; pointers are aligned to MixGraph::kAlignment bytes.
+class BusEffect {
+    public:
+        virtual ~BusEffect() {}
+        virtual void process(float *const *buffers, int channels, int frames) = 0;
+};
+
+// Soft knee for the master stage so that summed groups never hard-clip
+// the device. Samples below threshold pass unchanged; above it they bend
+// smoothly towards full scale.
+class SoftClip : public BusEffect {
+    public:
+        explicit SoftClip(float threshold = 0.9f) : threshold(threshold) {}
+        void process(float *const *buffers, int channels, int frames) override;
+
+        const float threshold;
+};
+
+// Block-based mixer: voice groups render into their own bus, each bus
+// applies its effects and gain, then feeds its output bus and any sends,
+// ending at the master bus which is written to the device buffer.
+//
+// All bus buffers are allocated once, in configure(), as one aligned
+// slab. Graph edits (addBus, route, addSend, addEffect) recompute the
+// processing order and must be made while audio is stopped; gains may be
+// changed from any thread.
+class MixGraph {
+    public:
+        static const int kMaster = 0;
+        static const int kAlignment = 64; // bytes
+
+        MixGraph();
+
+        // Allocate buffers for blocks of up to maxFrames frames.
+        void configure(int channels, int maxFrames, double sampleRate);
+
+        // New bus feeding `output` (the master by default). Returns its id.
+        int addBus(const std::string &name, int output = kMaster);
+        // Returns false if routing bus to output would create a cycle.
+        bool route(int bus, int output);
+        bool addSend(int bus, int target, float gain);
+        void addEffect(int bus, std::shared_ptr<BusEffect> effect);
+
+        void gain(int bus, float g) { mBuses[bus]->gain = g; }
+        float gain(int bus) const { return mBuses[bus]->gain; }
+        int find(const std::string &name) const;
+        int channels() const { return mChannels; }
+
+        // Start a block of `frames` frames: clear every bus.
+        void beginBlock(int frames);
+
+        // Run renderFunc(AudioIOData &) into a cleared scratch buffer of
+        // the beginBlock() size and add the result to the bus. Used to
+        // render a PolySynth or sequencer as one voice group, which then
+        // advances by exactly that many frames.
+        template <class RenderFunc>
+        void renderGroup(int bus, RenderFunc &&renderFunc) {
+            mScratch.framesPerBuffer(mFrames); // within the maxFrames configure() allocated
+            mScratch.zeroOut();
+            mScratch.frame(0);
+            renderFunc(mScratch);
+            accumulate(bus, mScratch);
+        }
+
+        // Direct access to a bus buffer, for code writing into it itself.
+        float *buffer(int bus, int channel) { return mBuses[bus]->channels[channel]; }
+
+        // Process every bus in order and add the master to io's outputs.
+        void process(AudioIOData &io);
+
+    private:
+        struct Send {
+            int target;
+            float gain;
+        };
+
+        struct Bus {
+            std::string name;
+            int output = -1;           // -1 for the master
+            std::vector<Send> sends;
+            std::vector<std::shared_ptr<BusEffect>> effects;
+            std::atomic<float> gain{1.f};
+            float lastGain = 1.f;      // gain reached at the end of last block
+            std::vector<float *> channels;
+        };
+
+        void accumulate(int bus, const AudioIOData &io);
+        void allocate();
+        bool feeds(int from, int to) const;
+        void updateOrder();
+
+        std::vector<std::unique_ptr<Bus>> mBuses;
+        std::vector<int> mOrder;       // sources first, master last
+        std::vector<float> mSlab;
+        AudioIOData mScratch;
+        int mChannels = 0;
+        int mMaxFrames = 0;
+        int mStride = 0;               // floats between channel buffers
+        int mFrames = 0;
+};
+
+#endif
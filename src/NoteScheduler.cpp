@@ -0,0 +1,199 @@
+#include <algorithm>
+
+#include "NoteScheduler.hpp"
+#include "RtSafety.hpp"
+
+NoteScheduler::NoteScheduler()
+    : mIncoming(kMaxPending), mPending(kMaxPending), mTaken(kMaxPending)
+{
+    // Sized once; the audio thread only moves within this capacity
+    mPending.clear();
+    mTaken.clear();
+    mChunk.reserve(kMaxPending);
+    mActive.capacity(kMaxActive);
+}
+
+void NoteScheduler::fromSequence(const Sequence &s, const TempoMap &tempo, std::vector<NoteEvent> &out)
+{
+    out.reserve(out.size() + s.getNotes()->size());
+    for (const Note &note : *s.getNotes()) {
+        const int64_t start = TempoMap::ticks(note.getTime());
+        const int64_t frame = tempo.frame(start);
+        const int64_t end = tempo.frame(start + TempoMap::ticks(note.getDuration()));
+        out.push_back({frame, (int32_t)std::max<int64_t>(1, end - frame), note.getFreq(), note.getAmp(),
+                       0.01f, 0.05f, 0.f});
+    }
+}
+
+void NoteScheduler::dropBacklogIfStopped()
+{
+    if (mDropBacklog.exchange(false)) {
+        mBacklog.clear();
+        mBacklogNext = 0;
+    }
+}
+
+size_t NoteScheduler::schedule(PolySynth &synth, const NoteEvent *events, size_t count, VoiceTaker getVoice,
+                               bool absolute)
+{
+    dropBacklogIfStopped();
+    if (count == 0) {
+        return 0;
+    }
+
+    const int64_t base = absolute ? 0 : now();
+    const size_t first = mBacklog.size();
+    for (size_t i = 0; i < count; i++) {
+        mBacklog.push_back({events[i], getVoice});
+        mBacklog.back().event.frame += base;
+    }
+    auto queuedEarlier = [](const Queued &a, const Queued &b) { return a.event.frame < b.event.frame; };
+    // Batches are usually in order already
+    const auto begin = mBacklog.begin() + first;
+    if (!std::is_sorted(begin, mBacklog.end(), queuedEarlier)) {
+        std::stable_sort(begin, mBacklog.end(), queuedEarlier);
+    }
+    std::inplace_merge(mBacklog.begin() + mBacklogNext, begin, mBacklog.end(), queuedEarlier);
+
+    update(synth);
+    return count;
+}
+
+void NoteScheduler::update(PolySynth &synth)
+{
+    dropBacklogIfStopped();
+
+    // As many due notes as fit in the ring without taking the audio
+    // thread's pending events past kMaxPending
+    const int64_t until = now() + horizon;
+    const size_t room = std::min<size_t>(mIncoming.writeAvailable(),
+                                         kMaxPending - mInFlight.load(std::memory_order_acquire));
+    size_t end = mBacklogNext;
+    while (end < mBacklog.size() && end - mBacklogNext < room && mBacklog[end].event.frame < until) {
+        end++;
+    }
+    if (end == mBacklogNext) {
+        return;
+    }
+
+    // Every voice of the chunk first, then the parameters
+    mChunk.clear();
+    for (size_t i = mBacklogNext; i < end; i++) {
+        const NoteEvent &e = mBacklog[i].event;
+        mChunk.push_back({e.frame, e.durationFrames, mBacklog[i].getVoice(synth), nullptr});
+    }
+    for (size_t i = mBacklogNext; i < end; i++) {
+        Entry &entry = mChunk[i - mBacklogNext];
+        if (!entry.voice) {
+            mNoVoice++;
+            continue;
+        }
+        const Queued &q = mBacklog[i];
+        if (!mParams.resolved(q.getVoice)) {
+            mParams.resolve(q.getVoice, *entry.voice);
+        }
+        mParams.set(TriggerParams::kAmplitude, q.event.amp);
+        mParams.set(TriggerParams::kFrequency, q.event.freq);
+        mParams.set(TriggerParams::kAttack, q.event.attack);
+        mParams.set(TriggerParams::kRelease, q.event.release);
+        mParams.set(TriggerParams::kPan, q.event.pan);
+        mParams.apply(*entry.voice);
+        entry.amp = mParams.parameter(*entry.voice, TriggerParams::kAmplitude);
+    }
+    mChunk.erase(std::remove_if(mChunk.begin(), mChunk.end(), [](const Entry &e) { return !e.voice; }),
+                 mChunk.end());
+
+    // Handed-over notes leave the backlog; compact it once most of it is spent
+    mBacklogNext = end;
+    if (mBacklogNext == mBacklog.size()) {
+        mBacklog.clear();
+        mBacklogNext = 0;
+    } else if (mBacklogNext >= (size_t)kMaxPending && mBacklogNext * 2 >= mBacklog.size()) {
+        mBacklog.erase(mBacklog.begin(), mBacklog.begin() + mBacklogNext);
+        mBacklogNext = 0;
+    }
+
+    // Counted before they are visible, so the audio thread's count never goes negative
+    mInFlight.fetch_add((int)mChunk.size(), std::memory_order_release);
+    mIncoming.write(mChunk.data(), mChunk.size());
+}
+
+int NoteScheduler::nextId()
+{
+    const int id = mNextId;
+    mNextId = mNextId == INT32_MAX ? 1 << 30 : mNextId + 1;
+    return id;
+}
+
+// Take up the chunks written since the last block and merge them into the
+// pending events from the back, in place. update() keeps the total within
+// kMaxPending.
+void NoteScheduler::merge()
+{
+    const size_t taken = mIncoming.readAvailable();
+    if (taken == 0) {
+        return;
+    }
+    mTaken.resize(taken); // within the capacity reserved at construction
+    mIncoming.read(mTaken.data(), taken);
+    // Several chunks may arrive together, each sorted on its own
+    std::sort(mTaken.begin(), mTaken.end(), earlier);
+
+    // Drop what has been played, then merge from the back
+    mPending.erase(mPending.begin(), mPending.begin() + mNext);
+    mNext = 0;
+    size_t a = mPending.size();
+    size_t b = taken;
+    mPending.resize(a + b);
+    for (size_t out = a + b; b > 0; out--) {
+        if (a > 0 && mPending[a - 1].frame > mTaken[b - 1].frame) {
+            mPending[out - 1] = mPending[--a];
+        } else {
+            mPending[out - 1] = mTaken[--b];
+        }
+    }
+    mTaken.clear();
+}
+
+// Pending voices have to go back to the synth: start them silent and
+// release them at once
+void NoteScheduler::retire(PolySynth &synth)
+{
+    for (size_t i = mNext; i < mPending.size(); i++) {
+        const Entry &e = mPending[i];
+        if (e.amp) {
+            e.amp->set(0.f);
+        }
+        const int id = nextId();
+        synth.triggerOn(e.voice, 0, id);
+        synth.triggerOff(id);
+    }
+    mInFlight.fetch_sub((int)(mPending.size() - mNext), std::memory_order_release);
+    mPending.clear();
+    mNext = 0;
+    mActive.releaseAll(synth);
+}
+
+void NoteScheduler::process(AudioIOData &io, PolySynth &synth)
+{
+    RT_SAFETY_SCOPE("NoteScheduler::process");
+
+    merge();
+    if (mStop.exchange(false)) {
+        retire(synth);
+    }
+
+    const int64_t end = mNow + io.framesPerBuffer();
+    mActive.releaseBefore(synth, end);
+    const size_t first = mNext;
+    for (; mNext < mPending.size() && mPending[mNext].frame < end; mNext++) {
+        const Entry &e = mPending[mNext];
+        const int offset = (int)std::max<int64_t>(0, e.frame - mNow);
+        const int id = nextId();
+        synth.triggerOn(e.voice, offset, id);
+        mActive.add(synth, id, e.frame + e.durationFrames);
+    }
+    mInFlight.fetch_sub((int)(mNext - first), std::memory_order_release);
+    mNow = end;
+    mClock.store(end, std::memory_order_release);
+}
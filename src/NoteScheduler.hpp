@@ -0,0 +1,144 @@
+#ifndef NOTESCHEDULER_HPP
+#define NOTESCHEDULER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "al/scene/al_PolySynth.hpp"
+
+#include "RingBuffer.hpp"
+#include "ScoreVoices.hpp"
+#include "Sequence.hpp"
+#include "TempoMap.hpp"
+
+using namespace al;
+
+// One note for NoteScheduler::schedule(), timed in frames from when it is
+// scheduled, or for scheduleAt(), in frames on the scheduler's clock
+struct NoteEvent {
+    int64_t frame;
+    int32_t durationFrames;
+    float freq;
+    float amp;
+    float attack;
+    float release;
+    float pan;
+};
+
+// Schedules whole batches of notes at once, where playNote() costs a
+// getVoice(), five name lookups and a sorted list insertion per note.
+// schedule() sorts a batch of any size into a backlog on the calling
+// thread. update() hands the notes due within `horizon` frames to the
+// audio thread in chunks: it reserves every voice of a chunk in one pass,
+// writes each voice's trigger parameters with a single setTriggerParams()
+// call using indices resolved once per voice type, and passes the chunk
+// through a lock-free ring. At the next block the audio thread merges it
+// into its pending events in one linear pass, without allocating, then
+// triggers and releases the notes with sample offsets as ScorePlayer does.
+// Only the notes near the playhead hold voices, so a score of a million
+// notes needs no more of them than its busiest couple of seconds.
+//
+// PolySynth hands out voices one getVoice() call at a time, so reserving
+// a chunk is a tight loop over them; preallocate the voice pool so it
+// doesn't allocate.
+//
+// schedule() and update() must only be called from one thread at a time.
+class NoteScheduler {
+    public:
+        static const int kMaxPending = 16384; // handed to the audio thread, not yet started
+        static const int kMaxActive = 4096;   // sounding; past this the note ending soonest is released
+
+        NoteScheduler();
+
+        // The notes of s, with times from tempo and the envelope playNote() uses
+        static void fromSequence(const Sequence &s, const TempoMap &tempo, std::vector<NoteEvent> &out);
+
+        // Returns the number of notes scheduled, which is all of them. Notes
+        // the synth has no voice for when they come due are dropped and
+        // counted in noVoice().
+        template <class VoiceType>
+        size_t schedule(PolySynth &synth, const NoteEvent *events, size_t count) {
+            return schedule(synth, events, count, &takeVoice<VoiceType>);
+        }
+        template <class VoiceType>
+        size_t schedule(PolySynth &synth, const std::vector<NoteEvent> &events) {
+            return schedule<VoiceType>(synth, events.data(), events.size());
+        }
+        // The same with absolute frames, from now() on. Notes whose frame has
+        // already passed start at once.
+        template <class VoiceType>
+        size_t scheduleAt(PolySynth &synth, const std::vector<NoteEvent> &events) {
+            return schedule(synth, events.data(), events.size(), &takeVoice<VoiceType>, true);
+        }
+        size_t schedule(PolySynth &synth, const NoteEvent *events, size_t count, VoiceTaker getVoice,
+                        bool absolute = false);
+
+        // Hand the audio thread the notes now within the horizon. schedule()
+        // calls this too; call it regularly, e.g. once per frame, while a
+        // batch longer than the horizon plays.
+        void update(PolySynth &synth);
+
+        // Frames ahead of the clock that notes are handed over, with their voices
+        int64_t horizon = 2 * 48000;
+
+        // Notes not yet handed to the audio thread
+        size_t backlog() const { return mBacklog.size() - mBacklogNext; }
+        // Notes dropped because the synth had no voice for them
+        size_t noVoice() const { return mNoVoice; }
+
+        // Frames the audio thread has processed. Safe from any thread.
+        int64_t now() const { return mClock.load(std::memory_order_acquire); }
+
+        // Drop the backlog and everything pending and release what is
+        // sounding, at the next block. Safe from any thread.
+        void stop() {
+            mDropBacklog = true;
+            mStop = true;
+        }
+
+        // Audio thread, before the synth renders
+        void process(AudioIOData &io, PolySynth &synth);
+
+    private:
+        struct Queued {
+            NoteEvent event; // frame on the scheduler's clock
+            VoiceTaker getVoice;
+        };
+        struct Entry {
+            int64_t frame;
+            int32_t durationFrames;
+            SynthVoice *voice;
+            Parameter *amp; // silences the voice if it is retired unplayed
+        };
+
+        static bool earlier(const Entry &a, const Entry &b) { return a.frame < b.frame; }
+        void dropBacklogIfStopped();
+        void merge();
+        void retire(PolySynth &synth);
+        int nextId();
+
+        // Producer side
+        std::vector<Queued> mBacklog; // sorted by frame, from mBacklogNext on
+        size_t mBacklogNext = 0;
+        std::vector<Entry> mChunk;
+        TriggerParams mParams;
+        size_t mNoVoice = 0;
+        std::atomic<bool> mDropBacklog{false};
+
+        RingBuffer<Entry> mIncoming;
+        std::atomic<int> mInFlight{0}; // in mIncoming or mPending, never past kMaxPending
+        std::atomic<bool> mStop{false};
+        std::atomic<int64_t> mClock{0};
+
+        // Audio thread
+        int64_t mNow = 0;
+        std::vector<Entry> mPending; // sorted by frame, from mNext on
+        size_t mNext = 0;
+        std::vector<Entry> mTaken;   // drained from mIncoming this block
+        ActiveNotes mActive;
+        int mNextId = 1 << 30; // clear of keyboard and ScorePlayer ids
+};
+
+#endif
@@ -0,0 +1,137 @@
+#include "NoteStream.hpp"
+
+#ifdef __cpp_impl_coroutine
+
+#include <algorithm>
+#include <memory>
+#include <random>
+
+#include "Score.hpp"
+#include "TempoMap.hpp"
+#include "Tuning.hpp"
+
+NoteStream offset(NoteStream s, float beats)
+{
+    Note n;
+    while (s.next(n)) {
+        co_yield Note(n, beats);
+    }
+}
+
+NoteStream transpose(NoteStream s, float ratio)
+{
+    Note n;
+    while (s.next(n)) {
+        co_yield Note(n.getFreq() * ratio, n.getTime(), n.getDuration(), n.getAmp(), n.getAttack(),
+                      n.getRelease(), n.getDecay(), n.getSustain());
+    }
+}
+
+NoteStream merge(NoteStream a, NoteStream b)
+{
+    Note na, nb;
+    bool hasA = a.next(na);
+    bool hasB = b.next(nb);
+    while (hasA || hasB) {
+        if (hasA && (!hasB || na.getTime() <= nb.getTime())) {
+            co_yield na;
+            hasA = a.next(na);
+        } else {
+            co_yield nb;
+            hasB = b.next(nb);
+        }
+    }
+}
+
+NoteStream until(NoteStream s, float endBeat)
+{
+    Note n;
+    while (s.next(n) && n.getTime() < endBeat) {
+        co_yield n;
+    }
+}
+
+NoteStream fromSequence(Sequence s)
+{
+    std::vector<Note> &notes = *s.getNotes();
+    std::stable_sort(notes.begin(), notes.end(),
+                     [](const Note &a, const Note &b) { return a.getTime() < b.getTime(); });
+    for (const Note &n : notes) {
+        co_yield n;
+    }
+}
+
+NoteStream score(float offset)
+{
+    // Phrases overlap, so each is merged into the notes still to come
+    // from the earlier ones. A phrase is only built once the notes
+    // before its start have been taken.
+    NoteStream playing;
+    Note pending;
+    bool hasPending = false;
+    for (int n = 1; n <= kNumPhrases; n++) {
+        const float start = phraseStartBeat(n);
+        while (hasPending || (hasPending = playing.next(pending))) {
+            if (pending.getTime() >= start) {
+                break;
+            }
+            co_yield pending;
+            hasPending = false;
+        }
+        std::unique_ptr<Sequence> phrase(sequencePhrase(n, offset));
+        TimeSignature t;
+        Sequence placed(t);
+        placed.addSequence(phrase.get(), start, phraseAmp);
+        if (hasPending) {
+            // The note read ahead goes back in, in order
+            placed.add(pending);
+            hasPending = false;
+        }
+        playing = merge(std::move(playing), fromSequence(std::move(placed)));
+    }
+    Note n;
+    while (playing.next(n)) {
+        co_yield n;
+    }
+}
+
+NoteStream walk(uint32_t seed, float amp)
+{
+    static const int kPentatonic[] = {0, 3, 5, 7, 10};
+    std::minstd_rand rng(seed);
+    std::uniform_int_distribution<int> step(-2, 2);
+    std::uniform_int_distribution<int> dashes(1, 6);
+    // Position kept in ticks, so the walk doesn't drift however long it runs
+    const int64_t ticksPerDash = TempoMap::kTicksPerBeat / 6;
+    int degree = 5; // D4
+    int64_t tick = 0;
+    for (;;) {
+        degree = std::max(0, std::min(14, degree + step(rng)));
+        const int note = 50 + 12 * (degree / 5) + kPentatonic[degree % 5];
+        const int64_t duration = dashes(rng) * ticksPerDash;
+        co_yield Note(kConcertPitch.freq(note), (float)((double)tick / TempoMap::kTicksPerBeat),
+                      (float)((double)duration / TempoMap::kTicksPerBeat), amp, 0.05f, 0.2f);
+        tick += duration;
+    }
+}
+
+bool NoteSource::readUntil(float beat, Sequence &out)
+{
+    for (int read = 0; read < mMaxNotes; read++) {
+        if (!mHasPending) {
+            mHasPending = mStream.next(mPending);
+            if (!mHasPending) {
+                mFinished = true;
+                return false;
+            }
+        }
+        if (mPending.getTime() >= beat) {
+            break;
+        }
+        out.add(mPending);
+        mHasPending = false;
+    }
+    return true;
+}
+
+#endif
@@ -0,0 +1,137 @@
+#ifndef NOTESTREAM_HPP
+#define NOTESTREAM_HPP
+
+// Lazy note sources written as C++20 coroutines. A source co_yields
+// Notes in start order and only runs as far as the player has asked
+// for, so generative or endless pieces never build their whole output
+// up front the way the sequencePhraseN functions do:
+//
+//     NoteStream arpeggio(float root) {
+//         for (int i = 0;; i++) {
+//             co_yield Note(root * (1 + i % 4), i * dashLength, dashLength);
+//         }
+//     }
+//
+//     NoteSource source(merge(score(1.0f), offset(transpose(arpeggio(D4), 0.5f), 27 * dashLength)));
+//     source.readUntil(beat + lookahead, chunk); // from the control thread
+//
+// Only built when the compiler supports coroutines (__cpp_impl_coroutine);
+// everything here is absent otherwise.
+
+#ifdef __cpp_impl_coroutine
+
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <utility>
+
+#include "Sequence.hpp"
+
+class NoteStream {
+    public:
+        struct promise_type {
+            Note current;
+            std::exception_ptr error;
+
+            NoteStream get_return_object() { return NoteStream(Handle::from_promise(*this)); }
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            std::suspend_always final_suspend() noexcept { return {}; }
+            std::suspend_always yield_value(const Note &n) {
+                current = n;
+                return {};
+            }
+            void return_void() {}
+            void unhandled_exception() { error = std::current_exception(); }
+        };
+        using Handle = std::coroutine_handle<promise_type>;
+
+        NoteStream() = default;
+        NoteStream(NoteStream &&other) noexcept : mHandle(std::exchange(other.mHandle, nullptr)) {}
+        NoteStream &operator=(NoteStream &&other) noexcept {
+            if (this != &other) {
+                reset();
+                mHandle = std::exchange(other.mHandle, nullptr);
+            }
+            return *this;
+        }
+        NoteStream(const NoteStream &) = delete;
+        NoteStream &operator=(const NoteStream &) = delete;
+        ~NoteStream() { reset(); }
+
+        // Run the source up to its next note. Returns false once it has
+        // returned; exceptions thrown inside it are rethrown here.
+        bool next(Note &out) {
+            if (!mHandle || mHandle.done()) {
+                return false;
+            }
+            mHandle.resume();
+            if (mHandle.promise().error) {
+                std::rethrow_exception(std::exchange(mHandle.promise().error, nullptr));
+            }
+            if (mHandle.done()) {
+                return false;
+            }
+            out = mHandle.promise().current;
+            return true;
+        }
+
+    private:
+        explicit NoteStream(Handle h) : mHandle(h) {}
+        void reset() {
+            if (mHandle) {
+                mHandle.destroy();
+                mHandle = nullptr;
+            }
+        }
+
+        Handle mHandle;
+};
+
+// Composition. Each takes its inputs by value and is itself a lazy source.
+
+// Every note `beats` later
+NoteStream offset(NoteStream s, float beats);
+// Every frequency multiplied by ratio
+NoteStream transpose(NoteStream s, float ratio);
+// Both sources interleaved in start order
+NoteStream merge(NoteStream a, NoteStream b);
+// The notes starting before endBeat; ends an endless source
+NoteStream until(NoteStream s, float endBeat);
+
+// Sources
+
+// The notes of s in start order. s is copied into the source.
+NoteStream fromSequence(Sequence s);
+// The piece, as sequence(offset) builds it, but one phrase at a time
+NoteStream score(float offset = 1.0f);
+// An endless random walk over the D minor pentatonic, in dashes
+NoteStream walk(uint32_t seed, float amp = 0.1f);
+
+// Pulls notes from a NoteStream with bounded look-ahead, for feeding a
+// scheduler block by block. Holds at most one note the caller has not
+// yet asked for, and returns at most maxNotes per call so a burst in a
+// dense source can't stall the calling thread; the rest follow on the
+// next call.
+class NoteSource {
+    public:
+        NoteSource() = default;
+        explicit NoteSource(NoteStream s, int maxNotes = 1024)
+            : mStream(std::move(s)), mMaxNotes(maxNotes), mFinished(false) {}
+
+        // Add the notes starting before `beat` to out. Returns false once
+        // the source is exhausted.
+        bool readUntil(float beat, Sequence &out);
+        bool finished() const { return mFinished; }
+        void close() { *this = NoteSource(); }
+
+    private:
+        NoteStream mStream;
+        int mMaxNotes = 1024;
+        Note mPending;
+        bool mHasPending = false;
+        bool mFinished = true;
+};
+
+#endif
+
+#endif
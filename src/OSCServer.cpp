@@ -38,6 +38,45 @@ using std::cout;
 using std::endl;
 
 #include "SineEnv.hpp"
+#include "Tuning.hpp"
+#include "RtSafety.hpp"
+#include "RealtimeConfig.hpp"
+#include "ResourceUsage.hpp"
+#include "PresetCache.hpp"
+#include "RtLog.hpp"
+
+#include "al/io/al_AudioIO.hpp"
+
+#include <atomic>
+#include <csignal>
+#include <cstring>
+
+const unsigned short kPort = 16447;
+
+// "/note" with an id and a frequency starts a voice; frequency 0 releases
+// it. Shared by the windowed and headless servers.
+bool handleNoteMessage(PolySynth &synth, osc::Message &m)
+{
+    if (m.addressPattern() != "/note" || m.typeTags() != "if")
+    {
+        return false;
+    }
+    int id;
+    float freq;
+    m >> id >> freq;
+    rtlog::debug(rtlog::kOsc, "note {} {} Hz", id, freq);
+    if (freq > 0)
+    {
+        SineEnv *voice = synth.getVoice<SineEnv>();
+        voice->setInternalParameterValue("frequency", freq);
+        synth.triggerOn(voice, 0, id);
+    }
+    else
+    {
+        synth.triggerOff(id);
+    }
+    return true;
+}
 
 // App has osc::PacketHandler as base class
 struct MyApp : public App
@@ -51,6 +90,14 @@ struct MyApp : public App
     // or open later with `open` interface (at onCreate in this example)
     osc::Recv server;
 
+    // Thread priorities, CPU pinning and memory locking
+    RealtimeConfig realtime;
+
+    // For comparing against --headless
+    ResourceUsage usage;
+
+    // Every SineEnv preset, parsed once so shift+key recalls never read disk
+    PresetCache presets;
 
     // This function is called right after the window is created
     // It provides a grphics context to initialize ParameterGUI
@@ -66,16 +113,28 @@ struct MyApp : public App
 
         imguiInit();
 
+        // Presets live where the synth manager's preset handler keeps them
+        const int cached = presets.load("SineEnv", *synthManager.voice());
+        rtlog::info(rtlog::kSystem, "{} SineEnv presets cached", cached);
+
+        // Allocate voices now rather than on the audio thread
+        if (realtime.voicePool > 0)
+        {
+            synthManager.synth().allocatePolyphony<SineEnv>(realtime.voicePool);
+        }
+
         // Play example sequence. Comment this line to start from scratch
         // synthManager.synthSequencer().playSequence("synth1.synthSequence");
-        synthManager.synthRecorder().verbose(true);
+        // Notes are logged by rtlog (--log osc=debug) rather than printed
+        // from the receive thread
+        synthManager.synthRecorder().verbose(false);
 
         // Print out our IP address
         // std::cout << "SERVER: My IP is " << Socket::hostIP() << "\n";
 
         // port, address, timeout
         // "" as address for localhost
-        server.open(16447, "localhost", 0.05);
+        server.open(kPort, "localhost", 0.05);
 
         // Register ourself (osc::PacketHandler) with the server so onMessage
         // gets called.
@@ -89,6 +148,9 @@ struct MyApp : public App
     // The audio callback function. Called when audio hardware requires data
     void onSound(AudioIOData &io) override
     {
+        RT_SAFETY_SCOPE("onSound");
+        realtime.applyAudioThread();
+
         // THIS THIS THIS is where Andres suggests scheduling new events
         // define a counter... when I get here add the number of samples in block
         // when you get to target number, inject new sequence...
@@ -98,6 +160,19 @@ struct MyApp : public App
 
     void onAnimate(double dt) override
     {
+        // A recalled preset shows in the GUI from the next frame
+        presets.apply(*synthManager.voice());
+        if (realtime.audioReady())
+        {
+            printf("%s", realtime.report().c_str());
+        }
+        int preset;
+        double presetMs;
+        if (presets.lastLatency(preset, presetMs))
+        {
+            rtlog::info(rtlog::kSystem, "preset {} applied {} ms after recall", preset, presetMs);
+        }
+
         // The GUI is prepared here
         imguiBeginFrame();
         // Draw a window that contains the synth control panel
@@ -119,7 +194,11 @@ struct MyApp : public App
     // This gets called whenever we receive a packet
     void onMessage(osc::Message &m) override
     {
-        m.print();
+        realtime.applyOscThread();
+        if (handleNoteMessage(synthManager.synth(), m))
+        {
+            return;
+        }
         // Check that the address and tags match what we expect
         if (m.addressPattern() == "/test" && m.typeTags() == "si")
         {
@@ -128,9 +207,11 @@ struct MyApp : public App
             int val;
             m >> str >> val;
 
-            // Print out the extracted packet data
-            std::cout << "SERVER: recv " << str << " " << val << std::endl;
+            // Log the extracted packet data
+            rtlog::info(rtlog::kOsc, "recv {} {}", str, val);
+            return;
         }
+        rtlog::debug(rtlog::kOsc, "unhandled {} {}", m.addressPattern(), m.typeTags());
     }
 
     // Whenever a key is pressed, this function is called
@@ -145,7 +226,10 @@ struct MyApp : public App
         {
             // If shift pressed then keyboard sets preset
             int presetNumber = asciiToIndex(k.key());
-            synthManager.recallPreset(presetNumber);
+            if (!presets.recall(presetNumber))
+            {
+                rtlog::warn(rtlog::kSystem, "no cached preset {}", presetNumber);
+            }
         }
         else
         {
@@ -153,8 +237,10 @@ struct MyApp : public App
             int midiNote = asciiToMIDI(k.key());
             if (midiNote > 0)
             {
+                // A preset recalled since the last frame applies whole
+                presets.apply(*synthManager.voice());
                 synthManager.voice()->setInternalParameterValue(
-                    "frequency", ::pow(2.f, (midiNote - 69.f) / 12.f) * 432.f);
+                    "frequency", kVerdiPitch.freq(midiNote));
                 synthManager.triggerOn(midiNote);
             }
         }
@@ -171,11 +257,125 @@ struct MyApp : public App
         return true;
     }
 
-    void onExit() override { imguiShutdown(); }
+    void onExit() override
+    {
+        printf("windowed: %s\n", usage.report().c_str());
+        imguiShutdown();
+    }
+};
+
+// The voice server without a window: no ImGui, no control panel and no
+// per-voice meshes drawn, just the OSC receive thread feeding a PolySynth
+// that renders in the audio callback. Runs until SIGINT or SIGTERM.
+struct HeadlessServer : public osc::PacketHandler
+{
+    PolySynth synth;
+    AudioIO audioIO;
+    osc::Recv server;
+    RealtimeConfig realtime;
+    ResourceUsage usage;
+
+    static std::atomic<bool> &quit()
+    {
+        static std::atomic<bool> flag{false};
+        return flag;
+    }
+
+    static void audioCallback(AudioIOData &io)
+    {
+        HeadlessServer &self = io.user<HeadlessServer>();
+        RT_SAFETY_SCOPE("onSound");
+        self.realtime.applyAudioThread();
+        self.synth.render(io);
+    }
+
+    void onMessage(osc::Message &m) override
+    {
+        realtime.applyOscThread();
+        handleNoteMessage(synth, m);
+    }
+
+    int run()
+    {
+        realtime.applyProcess();
+        if (!audioIO.init(audioCallback, this, 512, 48000, 2, 0))
+        {
+            printf("headless: can't open the audio device\n");
+            return 1;
+        }
+        gam::sampleRate(audioIO.framesPerSecond());
+        synth.allocatePolyphony<SineEnv>(realtime.voicePool > 0 ? realtime.voicePool : 64);
+
+        if (!server.open(kPort, "localhost", 0.05))
+        {
+            printf("headless: can't listen on port %d\n", kPort);
+            return 1;
+        }
+        server.handler(*this);
+        server.start();
+        audioIO.start();
+        printf("headless: listening on port %d, Ctrl-C to quit\n", kPort);
+
+        signal(SIGINT, [](int) { quit() = true; });
+        signal(SIGTERM, [](int) { quit() = true; });
+        usage.mark();
+        for (int second = 1; !quit(); second++)
+        {
+            al::wait(1.0);
+            if (realtime.audioReady())
+            {
+                printf("%s", realtime.report().c_str());
+            }
+            if (second % 10 == 0)
+            {
+                printf("headless: %s\n", usage.report().c_str());
+            }
+        }
+
+        audioIO.stop();
+        server.stop();
+        printf("headless: %s\n", usage.report().c_str());
+        return 0;
+    }
 };
 
-int main()
+void parseArgs(int argc, char *argv[], RealtimeConfig &realtime)
 {
-    cout << __FILE__ << endl;
-    MyApp().start();
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--log") == 0 && i + 1 < argc)
+        {
+            if (!rtlog::parseLevels(argv[++i]))
+            {
+                printf("bad log levels %s\n%s\n", argv[i], rtlog::usage());
+            }
+        }
+        else if (strcmp(argv[i], "--headless") != 0 && !realtime.parseArg(argc, argv, i))
+        {
+            printf("unknown option %s\noptions: --headless, %s, %s\n", argv[i], rtlog::usage(),
+                   RealtimeConfig::usage());
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    rtlog::start();
+    rtlog::threadName("main");
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--headless") == 0)
+        {
+            HeadlessServer headless;
+            parseArgs(argc, argv, headless.realtime);
+            const int result = headless.run();
+            rtlog::stop();
+            return result;
+        }
+    }
+    MyApp app;
+    parseArgs(argc, argv, app.realtime);
+    app.realtime.applyProcess();
+    app.start();
+    rtlog::stop();
 }
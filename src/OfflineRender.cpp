@@ -0,0 +1,64 @@
+#include <algorithm>
+#include <cmath>
+
+#include "OfflineRender.hpp"
+
+OfflineRenderer::OfflineRenderer(double sampleRate, float bpm, VoiceSettings voice)
+    : mSampleRate(sampleRate), mBpm(bpm), mSettings(voice), mVoice(new SineEnv)
+{
+    mIO.framesPerSecond(sampleRate);
+    mIO.framesPerBuffer(kBlockSize);
+    mIO.channels(2, true);
+    mVoice->init();
+}
+
+void OfflineRenderer::render(const Sequence &s, StereoBuffer &out, float ampMult)
+{
+    for (const Note &note : *s.getNotes()) {
+        render(note, out, ampMult);
+    }
+}
+
+void OfflineRenderer::render(const Note &n, StereoBuffer &out, float ampMult)
+{
+    const double framesPerBeat = 60.0 / mBpm * mSampleRate;
+    const int start = (int)std::lround(n.getTime() * framesPerBeat);
+    const int hold = std::max(1, (int)std::lround(n.getDuration() * framesPerBeat));
+    // Release tails are a few hundred ms; this only stops runaway voices
+    const int limit = hold + (int)(mSampleRate * 10.0);
+
+    SineEnv &voice = *mVoice;
+    voice.setInternalParameterValue("amplitude", n.getAmp() * ampMult);
+    voice.setInternalParameterValue("frequency", n.getFreq());
+    voice.setInternalParameterValue("attackTime", mSettings.attackTime);
+    voice.setInternalParameterValue("releaseTime", mSettings.releaseTime);
+    voice.setInternalParameterValue("pan", mSettings.pan);
+    voice.mOsc.phase(0);
+    voice.triggerOn();
+
+    bool released = false;
+    for (int pos = 0; voice.active() && pos < limit; pos += kBlockSize) {
+        if (!released && pos >= hold) {
+            voice.triggerOff();
+            released = true;
+        }
+        mIO.zeroOut();
+        mIO.frame(0);
+        voice.onProcess(mIO);
+        mVoiceFrames += kBlockSize;
+
+        const int at = start + pos;
+        if (out.frames() < at + kBlockSize) {
+            out.resize(at + kBlockSize);
+        }
+        const float *l = mIO.outBuffer(0);
+        const float *r = mIO.outBuffer(1);
+        for (int i = 0; i < kBlockSize; i++) {
+            out.left[at + i] += l[i];
+            out.right[at + i] += r[i];
+        }
+    }
+    if (voice.active()) {
+        voice.free();
+    }
+}
@@ -0,0 +1,68 @@
+#ifndef OFFLINERENDER_HPP
+#define OFFLINERENDER_HPP
+
+#include <memory>
+#include <vector>
+
+#include "al/io/al_AudioIOData.hpp"
+
+#include "Sequence.hpp"
+#include "SineEnv.hpp"
+
+using namespace al;
+
+// Trigger settings that playNote() gives every SineEnv voice
+struct VoiceSettings {
+    float attackTime = 0.01f;
+    float releaseTime = 0.05f;
+    float pan = 0.f;
+
+    bool operator==(const VoiceSettings &v) const {
+        return attackTime == v.attackTime && releaseTime == v.releaseTime && pan == v.pan;
+    }
+    bool operator!=(const VoiceSettings &v) const { return !(*this == v); }
+};
+
+struct StereoBuffer {
+    std::vector<float> left;
+    std::vector<float> right;
+
+    int frames() const { return left.size(); }
+    void resize(int frames) { left.resize(frames, 0.f); right.resize(frames, 0.f); }
+};
+
+// Renders a Sequence the way playNote() would play it, with SineEnv
+// voices but no audio device or sequencer. Note starts are sample
+// accurate; releases happen on kBlockSize boundaries, as they would at
+// the default sub-block size. Each note starts from oscillator phase 0,
+// so the same notes always render to the same samples.
+class OfflineRenderer {
+    public:
+        static const int kBlockSize = 64;
+
+        OfflineRenderer(double sampleRate, float bpm, VoiceSettings voice = VoiceSettings());
+
+        // Add every note of s to out, beat 0 at frame 0. out grows to hold
+        // the release tails but is never cleared.
+        void render(const Sequence &s, StereoBuffer &out, float ampMult = 1.f);
+        void render(const Note &n, StereoBuffer &out, float ampMult = 1.f);
+
+        double sampleRate() const { return mSampleRate; }
+        float bpm() const { return mBpm; }
+        const VoiceSettings &voiceSettings() const { return mSettings; }
+        // Frames rendered by voices so far, summed over notes
+        long long voiceFrames() const { return mVoiceFrames; }
+
+    private:
+        double mSampleRate;
+        float mBpm;
+        VoiceSettings mSettings;
+        AudioIOData mIO;
+        long long mVoiceFrames = 0;
+        // One voice reused for every note. Gamma unit generators register
+        // with the global domain when constructed, so renderers must be
+        // created on one thread even if they render on others.
+        std::unique_ptr<SineEnv> mVoice;
+};
+
+#endif
@@ -0,0 +1,132 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "PackedScore.hpp"
+
+namespace {
+    uint32_t ticks(float beats)
+    {
+        return (uint32_t)std::max(0L, std::lround(beats * PackedScore::kTicksPerBeat));
+    }
+
+    // Envelope parameters quantized to bfloat16: 8 bits of mantissa is
+    // plenty for times and levels, and all four fit one 64-bit key
+    uint64_t toHalf(float v)
+    {
+        uint32_t bits;
+        memcpy(&bits, &v, sizeof(bits));
+        bits += 0x7fff + ((bits >> 16) & 1); // round to nearest even
+        return bits >> 16;
+    }
+
+    float fromHalf(uint64_t h)
+    {
+        const uint32_t bits = (uint32_t)(h & 0xffff) << 16;
+        float v;
+        memcpy(&v, &bits, sizeof(v));
+        return v;
+    }
+
+    uint64_t envelopeKey(const Note &n)
+    {
+        return toHalf(n.getAttack()) << 48 | toHalf(n.getRelease()) << 32 |
+               toHalf(n.getDecay()) << 16 | toHalf(n.getSustain());
+    }
+}
+
+PackedScore::PackedScore(const TuningTable &tuning) : mTuning(tuning)
+{
+    for (int k = 0; k < kPitchSteps; k++) {
+        mFine[k] = std::pow(2.f, k / (12.f * kPitchSteps));
+    }
+}
+
+void PackedScore::add(const Note &n)
+{
+    // The table note at or below the frequency, then the steps above it
+    int note = 0;
+    while (note + 1 < TuningTable::kNotes && mTuning.freq(note + 1) <= n.getFreq()) {
+        note++;
+    }
+    const float steps = 12.f * kPitchSteps * std::log2(n.getFreq() / mTuning.freq(note));
+    // Also catches zero and negative frequencies, whose log is not a number
+    bool clamped = !(steps >= -0.5f);
+    int fine = clamped ? 0 : (int)std::lround(steps);
+    if (fine >= kPitchSteps) {
+        if (note + 1 < TuningTable::kNotes) {
+            note++;
+            fine = 0;
+        } else {
+            fine = kPitchSteps - 1;
+            clamped = true;
+        }
+    }
+    mClamped += clamped;
+
+    PackedNote p;
+    p.tick = ticks(n.getTime());
+    p.duration = ticks(n.getDuration());
+    p.pitch = note * kPitchSteps + fine;
+    p.amp = (uint8_t)std::lround(std::sqrt(std::min(std::max(n.getAmp(), 0.f), 1.f)) * 255.f);
+    p.envelope = envelopeId(n);
+    mNotes.push_back(p);
+}
+
+void PackedScore::add(const Sequence &s)
+{
+    reserve(size() + s.getNotes()->size());
+    for (const Note &n : *s.getNotes()) {
+        add(n);
+    }
+}
+
+void PackedScore::sort()
+{
+    std::stable_sort(mNotes.begin(), mNotes.end(),
+                     [](const PackedNote &a, const PackedNote &b) { return a.tick < b.tick; });
+}
+
+Note PackedScore::note(const PackedNote &n) const
+{
+    const EnvelopePreset &e = mEnvelopes[n.envelope];
+    return Note(freq(n), beats(n.tick), beats(n.duration), amp(n), e.attack, e.release, e.decay, e.sustain);
+}
+
+Sequence *PackedScore::toSequence() const
+{
+    TimeSignature t;
+    Sequence *result = new Sequence(t);
+    for (const PackedNote &n : mNotes) {
+        result->add(note(n));
+    }
+    return result;
+}
+
+uint8_t PackedScore::envelopeId(const Note &n)
+{
+    const uint64_t key = envelopeKey(n);
+    auto it = mEnvelopeIds.find(key);
+    if (it != mEnvelopeIds.end()) {
+        return it->second;
+    }
+
+    const EnvelopePreset e = {fromHalf(key >> 48), fromHalf(key >> 32), fromHalf(key >> 16), fromHalf(key)};
+    if (mEnvelopes.size() < 256) {
+        mEnvelopes.push_back(e);
+        return mEnvelopeIds[key] = mEnvelopes.size() - 1;
+    }
+    // Table full: share the closest preset
+    int best = 0;
+    float bestDistance = 1e30f;
+    for (int i = 0; i < (int)mEnvelopes.size(); i++) {
+        const EnvelopePreset &p = mEnvelopes[i];
+        const float d = std::abs(p.attack - e.attack) + std::abs(p.release - e.release) +
+                        std::abs(p.decay - e.decay) + std::abs(p.sustain - e.sustain);
+        if (d < bestDistance) {
+            best = i;
+            bestDistance = d;
+        }
+    }
+    return mEnvelopeIds[key] = best;
+}
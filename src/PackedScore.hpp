@@ -0,0 +1,77 @@
+#ifndef PACKEDSCORE_HPP
+#define PACKEDSCORE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "Sequence.hpp"
+#include "Tuning.hpp"
+
+// A note in 12 bytes instead of Note's 32: fixed-point beat time, pitch
+// as an index into the score's tuning table, squared-law quantized
+// amplitude and the id of a shared envelope preset. Decoding needs the
+// PackedScore the note belongs to.
+struct PackedNote {
+    uint32_t tick;     // start, in PackedScore::kTicksPerBeat
+    uint32_t duration; // ticks
+    uint16_t pitch;    // note * kPitchSteps + fine steps above it
+    uint8_t amp;       // amplitude = (amp / 255)^2
+    uint8_t envelope;  // index into PackedScore::envelopes()
+};
+
+// Attack, release, decay and sustain shared by many notes
+struct EnvelopePreset {
+    float attack, release, decay, sustain;
+};
+
+// A score of PackedNotes. Times are quantized to 1/960 beat (exact for
+// the score's dashes and note values), pitch to 1/256 semitone above the
+// nearest table note at or below it, and envelope parameters to 8-bit
+// mantissas; up to 256 distinct envelopes are kept, after which new ones
+// share the closest existing preset. Pitches outside the tuning table's
+// range are clamped to its ends and counted in clamped().
+class PackedScore {
+    public:
+        static const int kTicksPerBeat = 960;
+        static const int kPitchSteps = 256;
+
+        // Keeps its own copy of tuning
+        explicit PackedScore(const TuningTable &tuning = kConcertPitch);
+
+        void reserve(size_t n) { mNotes.reserve(n); }
+        void add(const Note &n);
+        void add(const Sequence &s);
+        // Stable sort by start tick
+        void sort();
+
+        size_t size() const { return mNotes.size(); }
+        const std::vector<PackedNote> &notes() const { return mNotes; }
+        const std::vector<EnvelopePreset> &envelopes() const { return mEnvelopes; }
+        size_t bytes() const { return mNotes.size() * sizeof(PackedNote); }
+        // Notes added with a pitch below the table's first note or more
+        // than a semitone above its last
+        size_t clamped() const { return mClamped; }
+
+        // Decoding
+        float freq(const PackedNote &n) const {
+            return mTuning.freq(n.pitch / kPitchSteps) * mFine[n.pitch % kPitchSteps];
+        }
+        static float amp(const PackedNote &n) { return n.amp * n.amp * (1.f / (255.f * 255.f)); }
+        static float beats(uint32_t ticks) { return ticks * (1.f / kTicksPerBeat); }
+        Note note(const PackedNote &n) const;
+        Sequence *toSequence() const;
+
+    private:
+        uint8_t envelopeId(const Note &n);
+
+        TuningTable mTuning;
+        float mFine[kPitchSteps]; // 2^(k / (12 * kPitchSteps))
+        std::vector<PackedNote> mNotes;
+        std::vector<EnvelopePreset> mEnvelopes;
+        std::unordered_map<uint64_t, uint8_t> mEnvelopeIds; // by quantized preset
+        size_t mClamped = 0;
+};
+
+#endif
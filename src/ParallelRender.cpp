@@ -0,0 +1,86 @@
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <thread>
+
+#include "ParallelRender.hpp"
+#include "Score.hpp"
+
+ParallelRenderer::ParallelRenderer(double sampleRate, int threads, VoiceSettings voice)
+    : mSampleRate(sampleRate), mThreads(threads), mSettings(voice)
+{
+    if (mThreads <= 0) {
+        mThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+}
+
+template <class Task>
+void ParallelRenderer::parallelFor(int count, Task &&task)
+{
+    std::atomic<int> next{0};
+    auto worker = [&] {
+        for (int i = next++; i < count; i = next++) {
+            task(i);
+        }
+    };
+    std::vector<std::thread> workers;
+    for (int t = 1; t < std::min(mThreads, count); t++) {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (auto &w : workers) {
+        w.join();
+    }
+}
+
+void ParallelRenderer::render(ScoreRender &r)
+{
+    std::vector<ScoreRender> renders(1);
+    renders[0].offset = r.offset;
+    renders[0].bpm = r.bpm;
+    render(renders);
+    std::swap(r.out, renders[0].out);
+}
+
+void ParallelRenderer::render(std::vector<ScoreRender> &renders)
+{
+    const int numJobs = renders.size() * kNumPhrases;
+
+    // A renderer per job, created here: SineEnv's Gamma objects register
+    // with the global domain on construction, which isn't thread safe
+    std::vector<std::unique_ptr<OfflineRenderer>> renderers;
+    for (int j = 0; j < numJobs; j++) {
+        renderers.emplace_back(new OfflineRenderer(mSampleRate, renders[j / kNumPhrases].bpm, mSettings));
+    }
+    std::vector<StereoBuffer> phrases(numJobs);
+
+    parallelFor(numJobs, [&](int j) {
+        const ScoreRender &r = renders[j / kNumPhrases];
+        Sequence *phrase = sequencePhrase(j % kNumPhrases + 1, r.offset);
+        renderers[j]->render(*phrase, phrases[j], phraseAmp);
+        delete phrase;
+    });
+
+    // Sum each render's phrases in phrase order; renders are independent
+    parallelFor(renders.size(), [&](int r) {
+        const double framesPerBeat = 60.0 / renders[r].bpm * mSampleRate;
+        StereoBuffer &out = renders[r].out;
+        for (int n = 1; n <= kNumPhrases; n++) {
+            const StereoBuffer &p = phrases[r * kNumPhrases + n - 1];
+            const int start = (int)std::lround(phraseStartBeat(n) * framesPerBeat);
+            if (out.frames() < start + p.frames()) {
+                out.resize(start + p.frames());
+            }
+            for (int i = 0; i < p.frames(); i++) {
+                out.left[start + i] += p.left[i];
+                out.right[start + i] += p.right[i];
+            }
+        }
+    });
+
+    mVoiceFrames = 0;
+    for (auto &renderer : renderers) {
+        mVoiceFrames += renderer->voiceFrames();
+    }
+}
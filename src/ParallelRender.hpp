@@ -0,0 +1,47 @@
+#ifndef PARALLELRENDER_HPP
+#define PARALLELRENDER_HPP
+
+#include <vector>
+
+#include "OfflineRender.hpp"
+
+// One rendering of the whole score, at a transposition and tempo
+struct ScoreRender {
+    float offset = 1.0f; // frequency multiplier, as for sequence()
+    float bpm = 77.0f;
+    StereoBuffer out;
+};
+
+// Renders the score offline with its phrases spread over several threads.
+// Phrases don't interact, so each (render, phrase) pair is rendered into
+// its own buffer by a fresh OfflineRenderer, and each render's phrases
+// are then summed at their start frames in phrase order. Which thread ran
+// which phrase never affects the result: output is bit-identical for any
+// thread count, including a single-threaded run.
+//
+// Renderers (and so their Gamma unit generators) are all created on the
+// calling thread before the workers start.
+class ParallelRenderer {
+    public:
+        // threads <= 0 uses every core
+        ParallelRenderer(double sampleRate, int threads = 0, VoiceSettings voice = VoiceSettings());
+
+        void render(std::vector<ScoreRender> &renders);
+        void render(ScoreRender &r);
+
+        int threads() const { return mThreads; }
+        // Frames rendered by voices in the last render(), summed over notes
+        long long voiceFrames() const { return mVoiceFrames; }
+
+    private:
+        // Run task(i) for i in [0, count) on the worker threads
+        template <class Task>
+        void parallelFor(int count, Task &&task);
+
+        double mSampleRate;
+        int mThreads;
+        VoiceSettings mSettings;
+        long long mVoiceFrames = 0;
+};
+
+#endif
@@ -0,0 +1,81 @@
+#include <cstring>
+
+#include "PhraseCache.hpp"
+
+namespace {
+    // 64-bit FNV-1a
+    const uint64_t kFnvOffset = 14695981039346656037ull;
+    const uint64_t kFnvPrime = 1099511628211ull;
+}
+
+size_t PhraseCache::KeyHash::operator()(const Key &k) const
+{
+    uint64_t h = kFnvOffset;
+    for (float v : k) {
+        uint32_t bits;
+        memcpy(&bits, &v, sizeof(bits));
+        for (int i = 0; i < 4; i++, bits >>= 8) {
+            h = (h ^ (bits & 0xff)) * kFnvPrime;
+        }
+    }
+    return (size_t)h;
+}
+
+void PhraseCache::configure(double sampleRate, float bpm, VoiceSettings voice)
+{
+    if (mRenderer && mRenderer->sampleRate() == sampleRate && mRenderer->bpm() == bpm &&
+        mRenderer->voiceSettings() == voice) {
+        return;
+    }
+    mRenderer.reset(new OfflineRenderer(sampleRate, bpm, voice));
+    clear();
+}
+
+std::shared_ptr<const StereoBuffer> PhraseCache::get(const Sequence &phrase, float offset, float ampMult)
+{
+    if (!mRenderer) {
+        return nullptr;
+    }
+    Key k = key(phrase, offset, ampMult);
+    auto it = mEntries.find(k);
+    if (it != mEntries.end()) {
+        mHits++;
+        return it->second;
+    }
+
+    mMisses++;
+    auto buffer = std::make_shared<StereoBuffer>();
+    mRenderer->render(phrase, *buffer, ampMult);
+    mEntries.emplace(std::move(k), buffer);
+    return buffer;
+}
+
+size_t PhraseCache::bytes() const
+{
+    size_t total = 0;
+    for (auto &entry : mEntries) {
+        total += 2 * entry.second->frames() * sizeof(float);
+    }
+    return total;
+}
+
+PhraseCache::Key PhraseCache::key(const Sequence &phrase, float offset, float ampMult) const
+{
+    const std::vector<Note> &notes = *phrase.getNotes();
+    Key k;
+    k.reserve(4 * notes.size() + 7);
+    for (const Note &n : notes) {
+        k.push_back(n.getFreq());
+        k.push_back(n.getTime());
+        k.push_back(n.getDuration());
+        k.push_back(n.getAmp());
+    }
+    k.push_back(offset);
+    k.push_back(ampMult);
+    k.push_back((float)mRenderer->sampleRate());
+    k.push_back(mRenderer->bpm());
+    k.push_back(mRenderer->voiceSettings().attackTime);
+    k.push_back(mRenderer->voiceSettings().releaseTime);
+    k.push_back(mRenderer->voiceSettings().pan);
+    return k;
+}
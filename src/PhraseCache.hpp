@@ -0,0 +1,50 @@
+#ifndef PHRASECACHE_HPP
+#define PHRASECACHE_HPP
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "OfflineRender.hpp"
+#include "Sequence.hpp"
+
+// Pre-rendered stereo audio of phrases, so that a phrase that has been
+// heard once (or repeats elsewhere in the score) plays back as a single
+// SampleVoice instead of one SineEnv per note.
+//
+// Entries are keyed by the phrase's notes, the transposition offset and
+// the render settings, compared in full on lookup so that a hash
+// collision can't return another phrase. Changing the settings through
+// configure() drops every entry.
+class PhraseCache {
+    public:
+        void configure(double sampleRate, float bpm, VoiceSettings voice = VoiceSettings());
+
+        // Rendering of phrase (with amplitudes scaled by ampMult), made on
+        // the calling thread on a miss.
+        std::shared_ptr<const StereoBuffer> get(const Sequence &phrase, float offset, float ampMult = 1.f);
+
+        void clear() { mEntries.clear(); }
+
+        int hits() const { return mHits; }
+        int misses() const { return mMisses; }
+        size_t bytes() const;
+
+    private:
+        // Every value the rendering depends on, in a fixed order
+        typedef std::vector<float> Key;
+
+        struct KeyHash {
+            size_t operator()(const Key &k) const;
+        };
+
+        Key key(const Sequence &phrase, float offset, float ampMult) const;
+
+        std::unique_ptr<OfflineRenderer> mRenderer;
+        std::unordered_map<Key, std::shared_ptr<const StereoBuffer>, KeyHash> mEntries;
+        int mHits = 0;
+        int mMisses = 0;
+};
+
+#endif
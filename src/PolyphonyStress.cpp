@@ -0,0 +1,39 @@
+#include "PolyphonyStress.hpp"
+
+void PolyphonyStress::endBlock(const AudioIOData &io)
+{
+    if (!mRunning) {
+        return;
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - mStart;
+    // The first block of a step pays for voice allocation; don't count it
+    if (mBlock > 0) {
+        mSum += elapsed.count();
+    }
+    if (++mBlock <= settleBlocks) {
+        return;
+    }
+
+    mDeadline = io.framesPerBuffer() / io.framesPerSecond();
+    double mean = mSum / settleBlocks;
+    mBlock = 0;
+    mSum = 0;
+    if (mean > mDeadline * deadlineShare || mVoices >= maxVoices) {
+        mResult = mVoices >= maxVoices ? mVoices : mVoices - step;
+        mRunning = false;
+    } else {
+        mSustainedMean = mean;
+    }
+}
+
+bool PolyphonyStress::finished(int &voices, double &renderMs, double &deadlineMs)
+{
+    int result = mResult.exchange(-1);
+    if (result < 0) {
+        return false;
+    }
+    voices = result;
+    renderMs = mSustainedMean * 1000.0;
+    deadlineMs = mDeadline * 1000.0;
+    return true;
+}
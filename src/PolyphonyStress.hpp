@@ -0,0 +1,48 @@
+#ifndef POLYPHONYSTRESS_HPP
+#define POLYPHONYSTRESS_HPP
+
+#include <atomic>
+#include <chrono>
+
+#include "al/io/al_AudioIOData.hpp"
+
+using namespace al;
+
+// Finds how many voices the machine can sustain. The app adds voices in
+// steps from its audio callback and wraps the synth render with
+// beginBlock()/endBlock(); once the mean render time of a step crosses
+// deadlineShare of the block duration, the previous step is reported as
+// the sustainable voice count.
+class PolyphonyStress {
+    public:
+        float deadlineShare = 0.5f; // share of the block duration we may use
+        int step = 8;               // voices added per step
+        int settleBlocks = 64;      // blocks measured per step
+        int maxVoices = 8192;       // give up ramping beyond this
+
+        void start() { mVoices = 0; mBlock = 0; mSum = 0; mSustainedMean = 0; mResult = -1; mRunning = true; }
+        bool running() const { return mRunning; }
+
+        // Number of voices to add before rendering this block.
+        int voicesToAdd() const { return mRunning && mBlock == 0 ? step : 0; }
+        void voicesAdded(int n) { mVoices += n; }
+
+        void beginBlock() { mStart = std::chrono::steady_clock::now(); }
+        void endBlock(const AudioIOData &io);
+
+        // Returns true once, after the ramp has finished, and fills in the
+        // result. Meant to be polled from a non-audio thread.
+        bool finished(int &voices, double &renderMs, double &deadlineMs);
+
+    private:
+        std::chrono::steady_clock::time_point mStart;
+        int mVoices = 0;
+        int mBlock = 0;
+        double mSum = 0;     // seconds rendered in the current step
+        double mSustainedMean = 0; // mean block time of the last sustainable step
+        double mDeadline = 0;
+        std::atomic<bool> mRunning{false};
+        std::atomic<int> mResult{-1};
+};
+
+#endif
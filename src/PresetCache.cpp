@@ -0,0 +1,132 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#include "PresetCache.hpp"
+
+namespace {
+    int64_t nowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    bool isNumber(const std::string &s) {
+        return !s.empty() && s.find_first_not_of("0123456789") == std::string::npos;
+    }
+}
+
+int PresetCache::load(const std::string &dir, SynthVoice &voice)
+{
+    mNames.clear();
+    std::vector<float> defaults;
+    for (ParameterMeta *meta : voice.triggerParameters()) {
+        mNames.push_back(meta->getName());
+        Parameter *p = dynamic_cast<Parameter *>(meta);
+        defaults.push_back(p ? p->get() : 0.f);
+    }
+    mValues.assign(kMaxPresets * mNames.size(), 0.f);
+    mLoaded.assign(kMaxPresets, false);
+    mCount = 0;
+
+    // "index:name" lines; without a map, presets are named by number
+    std::vector<std::pair<int, std::string>> presets;
+    std::ifstream map(dir + "/default.presetMap");
+    std::string line;
+    while (std::getline(map, line)) {
+        const size_t colon = line.find(':');
+        if (colon != std::string::npos && isNumber(line.substr(0, colon))) {
+            presets.emplace_back(atoi(line.c_str()), line.substr(colon + 1));
+        }
+    }
+    if (presets.empty()) {
+        for (int i = 0; i < kMaxPresets; i++) {
+            presets.emplace_back(i, std::to_string(i));
+        }
+    }
+
+    for (auto &preset : presets) {
+        const int index = preset.first;
+        if (index < 0 || index >= kMaxPresets) {
+            continue;
+        }
+        float *values = &mValues[index * mNames.size()];
+        std::copy(defaults.begin(), defaults.end(), values);
+        if (parse(dir + "/" + preset.second + ".preset", values)) {
+            mLoaded[index] = true;
+            mCount++;
+        }
+    }
+    return mCount;
+}
+
+// Preset files hold "/address f value" lines between "::name" and "::"
+bool PresetCache::parse(const std::string &path, float *values) const
+{
+    std::ifstream file(path);
+    if (!file) {
+        return false;
+    }
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] != '/') {
+            continue;
+        }
+        std::istringstream fields(line);
+        std::string address, types;
+        float value;
+        if (!(fields >> address >> types >> value) || types.empty() || types[0] != 'f') {
+            continue;
+        }
+        // The last path component is the parameter name
+        const std::string name = address.substr(address.rfind('/') + 1);
+        for (size_t i = 0; i < mNames.size(); i++) {
+            if (mNames[i] == name) {
+                values[i] = value;
+            }
+        }
+    }
+    return true;
+}
+
+bool PresetCache::has(int index) const
+{
+    return index >= 0 && index < kMaxPresets && mLoaded[index];
+}
+
+bool PresetCache::recall(int index)
+{
+    if (!has(index)) {
+        return false;
+    }
+    mRecallTime = nowNs();
+    mPending = index;
+    return true;
+}
+
+bool PresetCache::apply(SynthVoice &voice)
+{
+    const int index = mPending.exchange(-1);
+    if (index < 0) {
+        return false;
+    }
+    voice.setTriggerParams(&mValues[index * mNames.size()], parameters());
+    if (!mLatencyReady.load()) {
+        mAppliedIndex = index;
+        mLatencyMs = (nowNs() - mRecallTime.load()) / 1e6;
+        mLatencyReady = true;
+    }
+    return true;
+}
+
+bool PresetCache::lastLatency(int &index, double &ms)
+{
+    if (!mLatencyReady.load()) {
+        return false;
+    }
+    index = mAppliedIndex;
+    ms = mLatencyMs;
+    mLatencyReady = false;
+    return true;
+}
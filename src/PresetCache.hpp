@@ -0,0 +1,61 @@
+#ifndef PRESETCACHE_HPP
+#define PRESETCACHE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "al/scene/al_SynthVoice.hpp"
+
+using namespace al;
+
+// Every preset of a voice, read from the preset handler's text files
+// once at startup into a table of binary snapshots: one float per
+// trigger parameter, in the voice's triggerParameters() order. Recalling
+// a preset never touches the disk or parses anything. recall() only
+// posts the preset number; the thread that reads and edits the voice
+// (for SynthGUIManager's template voice, the main thread: the GUI and
+// triggerOn() both use it) copies the whole snapshot in with one
+// setTriggerParams() call before it next triggers a note from it, so no
+// note starts from a half-applied preset.
+class PresetCache {
+    public:
+        static const int kMaxPresets = 128;
+
+        // Parse `dir`/*.preset, numbered by `dir`/default.presetMap or
+        // else by file name ("3.preset"). Parameters a preset doesn't
+        // mention get the values voice had when load() was called. Returns
+        // the number of presets loaded.
+        int load(const std::string &dir, SynthVoice &voice);
+        bool has(int index) const;
+        int size() const { return mCount; }
+        int parameters() const { return (int)mNames.size(); }
+        const float *snapshot(int index) const { return &mValues[index * mNames.size()]; }
+
+        // Any thread. Returns false if there is no such preset.
+        bool recall(int index);
+        // The thread that owns voice, before triggering a note from it:
+        // apply the pending preset, if any
+        bool apply(SynthVoice &voice);
+
+        // Returns true once per applied recall, with the time from
+        // recall() to the snapshot being in place, in milliseconds.
+        bool lastLatency(int &index, double &ms);
+
+    private:
+        bool parse(const std::string &path, float *values) const;
+
+        std::vector<std::string> mNames;
+        std::vector<float> mValues; // kMaxPresets snapshots
+        std::vector<bool> mLoaded;
+        int mCount = 0;
+
+        std::atomic<int> mPending{-1};
+        std::atomic<int64_t> mRecallTime{0}; // steady_clock ns
+        std::atomic<bool> mLatencyReady{false};
+        int mAppliedIndex = -1;
+        double mLatencyMs = 0;
+};
+
+#endif
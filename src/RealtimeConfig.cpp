@@ -0,0 +1,206 @@
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+
+#include "RealtimeConfig.hpp"
+#include "RtLog.hpp"
+
+namespace {
+#if defined(__linux__)
+    const int kMaxCpus = CPU_SETSIZE;
+#else
+    const int kMaxCpus = 1024;
+#endif
+
+    // A CPU index, the whole of text; false for junk or out of range
+    bool parseCpu(const char *text, const char *end, int &cpu)
+    {
+        char *parsed;
+        errno = 0;
+        const long n = strtol(text, &parsed, 10);
+        if (parsed == text || parsed != end || errno != 0 || n < 0 || n >= kMaxCpus) {
+            return false;
+        }
+        cpu = (int)n;
+        return true;
+    }
+
+    bool parseCpu(const char *text, int &cpu) { return parseCpu(text, text + strlen(text), cpu); }
+
+    // Comma-separated CPU indices; cpus is left alone unless all are valid
+    bool parseCpuList(const char *text, std::vector<int> &cpus)
+    {
+        std::vector<int> parsed;
+        for (const char *p = text;; p++) {
+            const char *comma = strchr(p, ',');
+            const char *end = comma ? comma : p + strlen(p);
+            int cpu;
+            if (!parseCpu(p, end, cpu)) {
+                return false;
+            }
+            parsed.push_back(cpu);
+            if (!comma) {
+                break;
+            }
+            p = comma;
+        }
+        cpus = parsed;
+        return true;
+    }
+
+    // Returns 0 or an errno value
+    int pinCurrentThread(const int *cpus, int n)
+    {
+#if defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int i = 0; i < n; i++) {
+            if (cpus[i] < 0 || cpus[i] >= kMaxCpus) {
+                return EINVAL;
+            }
+            CPU_SET(cpus[i], &set);
+        }
+        return pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+        (void)cpus;
+        (void)n;
+        return ENOTSUP;
+#endif
+    }
+
+    // Touch the stack the callback will use so its pages are resident
+    // (and, after mlockall, locked) before the first real block
+    void prefaultStack()
+    {
+        volatile char stack[256 * 1024];
+        for (size_t i = 0; i < sizeof(stack); i += 4096) {
+            stack[i] = 0;
+        }
+    }
+
+    std::string cpuList(const std::vector<int> &cpus)
+    {
+        std::string s;
+        for (int cpu : cpus) {
+            s += (s.empty() ? "" : ",") + std::to_string(cpu);
+        }
+        return s;
+    }
+}
+
+bool RealtimeConfig::parseArg(int argc, char *argv[], int &i)
+{
+    const char *arg = argv[i];
+    const bool hasValue = i + 1 < argc;
+    if (strcmp(arg, "--rt-priority") == 0 && hasValue) {
+        priority = atoi(argv[++i]);
+    } else if ((strcmp(arg, "--audio-cpu") == 0 || strcmp(arg, "--osc-cpu") == 0) && hasValue) {
+        int &cpu = strcmp(arg, "--audio-cpu") == 0 ? audioCpu : oscCpu;
+        if (!parseCpu(argv[++i], cpu)) {
+            printf("realtime: bad CPU %s for %s (0 to %d), not pinning\n", argv[i], arg, kMaxCpus - 1);
+            cpu = -1;
+        }
+    } else if (strcmp(arg, "--worker-cpus") == 0 && hasValue) {
+        if (!parseCpuList(argv[++i], workerCpus)) {
+            printf("realtime: bad CPU list %s for %s (0 to %d, comma-separated), not pinning\n",
+                   argv[i], arg, kMaxCpus - 1);
+            workerCpus.clear();
+        }
+    } else if (strcmp(arg, "--mlock") == 0) {
+        lockMemory = true;
+        if (voicePool == 0) {
+            voicePool = 128;
+        }
+    } else if (strcmp(arg, "--voice-pool") == 0 && hasValue) {
+        voicePool = atoi(argv[++i]);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char *RealtimeConfig::usage()
+{
+    return "--rt-priority N, --audio-cpu N, --osc-cpu N, --worker-cpus A,B,..., "
+           "--mlock, --voice-pool N";
+}
+
+void RealtimeConfig::applyProcess()
+{
+    if (!workerCpus.empty()) {
+        mResult[kWorkers] = pinCurrentThread(workerCpus.data(), workerCpus.size());
+    }
+    if (lockMemory) {
+        mResult[kMemory] = mlockall(MCL_CURRENT | MCL_FUTURE) == 0 ? 0 : errno;
+    }
+}
+
+void RealtimeConfig::applyAudioThread()
+{
+    if (mAudioApplied.load(std::memory_order_relaxed)) {
+        return;
+    }
+    if (priority > 0) {
+        sched_param param;
+        param.sched_priority = priority;
+        mResult[kPriority] = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    }
+    if (audioCpu >= 0) {
+        mResult[kAudioCpu] = pinCurrentThread(&audioCpu, 1);
+    }
+    prefaultStack();
+    rtlog::threadName("audio");
+    mAudioApplied = true;
+}
+
+void RealtimeConfig::applyOscThread()
+{
+    if (mOscApplied.exchange(true)) {
+        return;
+    }
+    rtlog::threadName("osc");
+    if (oscCpu >= 0) {
+        mResult[kOscCpu] = pinCurrentThread(&oscCpu, 1);
+    }
+}
+
+std::string RealtimeConfig::report() const
+{
+    std::string s;
+    auto line = [&](int result, const std::string &what, const char *hint) {
+        s += "realtime: " + what + ": ";
+        if (result == kPending) {
+            s += "not applied yet\n";
+        } else if (result == 0) {
+            s += "ok\n";
+        } else {
+            s += std::string("failed (") + strerror(result) + ")";
+            s += (result == EPERM && hint) ? std::string(", ") + hint + "\n" : "\n";
+        }
+    };
+    if (!workerCpus.empty()) {
+        line(mResult[kWorkers], "workers on CPUs " + cpuList(workerCpus), nullptr);
+    }
+    if (lockMemory) {
+        line(mResult[kMemory], "mlockall", "raise the memlock limit (ulimit -l)");
+    }
+    if (priority > 0) {
+        line(mResult[kPriority], "audio thread SCHED_FIFO " + std::to_string(priority),
+             "raise the rtprio limit (ulimit -r) or grant CAP_SYS_NICE");
+    }
+    if (audioCpu >= 0) {
+        line(mResult[kAudioCpu], "audio thread on CPU " + std::to_string(audioCpu), nullptr);
+    }
+    if (oscCpu >= 0) {
+        line(mResult[kOscCpu], "OSC thread on CPU " + std::to_string(oscCpu), nullptr);
+    }
+    if (voicePool > 0) {
+        s += "realtime: " + std::to_string(voicePool) + " voices preallocated\n";
+    }
+    return s;
+}
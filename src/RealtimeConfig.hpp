@@ -0,0 +1,60 @@
+#ifndef REALTIMECONFIG_HPP
+#define REALTIMECONFIG_HPP
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+// Scheduling and memory settings for the real-time threads, shared by app
+// and oscServer. Every setting is best effort: if the process lacks the
+// permission (CAP_SYS_NICE / rtprio and memlock limits on Linux) or the
+// platform lacks the call, the failure is recorded and report() says
+// what was actually achieved.
+//
+// The audio and OSC receive threads are created inside allolib, so their
+// settings are applied lazily, from the first callback that runs on them.
+// Worker CPUs are applied to the main thread before anything else starts,
+// so every thread created afterwards inherits them unless it is re-pinned.
+class RealtimeConfig {
+    public:
+        int priority = 0;            // SCHED_FIFO priority for audio; 0 leaves it alone
+        int audioCpu = -1;           // -1 leaves the thread unpinned
+        int oscCpu = -1;
+        std::vector<int> workerCpus; // main thread and everything it starts
+        bool lockMemory = false;     // mlockall current and future pages
+        int voicePool = 0;           // voices to allocate up front
+
+        // Consume argv[i] (and its value) if it is one of ours:
+        //   --rt-priority N  --audio-cpu N  --osc-cpu N
+        //   --worker-cpus A,B,...  --mlock  --voice-pool N
+        // A CPU value that isn't a valid index is reported and that
+        // pinning left off.
+        bool parseArg(int argc, char *argv[], int &i);
+        static const char *usage();
+
+        // Main thread, before audio starts: worker pinning and mlockall
+        void applyProcess();
+        // First audio callback: SCHED_FIFO, pinning and stack prefault.
+        // Makes system calls once, then returns at once on later calls.
+        void applyAudioThread();
+        // First OSC message on the receive thread
+        void applyOscThread();
+
+        // Results so far, one line per setting that was asked for. Safe
+        // to call from the main thread at any time.
+        std::string report() const;
+        // True once, when the audio thread has applied its settings
+        bool audioReady() { return mAudioApplied && !mAudioReported.exchange(true); }
+
+    private:
+        enum { kWorkers, kMemory, kPriority, kAudioCpu, kOscCpu, kNumResults };
+        static const int kPending = -1;
+
+        // errno of each setting, 0 on success
+        std::atomic<int> mResult[kNumResults] = {{kPending}, {kPending}, {kPending}, {kPending}, {kPending}};
+        std::atomic<bool> mAudioApplied{false};
+        std::atomic<bool> mAudioReported{false};
+        std::atomic<bool> mOscApplied{false};
+};
+
+#endif
@@ -0,0 +1,145 @@
+/*
+Batch offline render of the score to WAV files, one per combination of
+transposition and tempo, with phrases rendered in parallel.
+
+Usage: render [options]
+  --offset A,B,...    frequency multipliers (default 1)
+  --bpm A,B,...       tempos (default 77)
+  --rate N            sample rate (default 48000)
+  --threads N         worker threads (default: every core)
+  --out DIR           output directory (default .)
+  --verify            also render on one thread and check the output matches
+*/
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "Gamma/Domain.h"
+
+#include "ParallelRender.hpp"
+#include "Score.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+std::vector<float> parseList(const char *s)
+{
+    std::vector<float> values;
+    for (const char *p = s; *p;) {
+        char *end;
+        values.push_back(strtof(p, &end));
+        p = *end == ',' ? end + 1 : end + strlen(end);
+    }
+    return values;
+}
+
+void put16(FILE *f, uint16_t v) { fputc(v & 0xff, f); fputc(v >> 8, f); }
+void put32(FILE *f, uint32_t v) { put16(f, v & 0xffff); put16(f, v >> 16); }
+
+// 32-bit float stereo WAV
+bool writeWav(const std::string &path, const StereoBuffer &b, double sampleRate)
+{
+    FILE *f = fopen(path.c_str(), "wb");
+    if (!f) {
+        return false;
+    }
+    const uint32_t dataBytes = b.frames() * 2 * sizeof(float);
+    fwrite("RIFF", 1, 4, f);
+    put32(f, 36 + dataBytes);
+    fwrite("WAVEfmt ", 1, 8, f);
+    put32(f, 16);
+    put16(f, 3); // WAVE_FORMAT_IEEE_FLOAT
+    put16(f, 2);
+    put32(f, (uint32_t)sampleRate);
+    put32(f, (uint32_t)sampleRate * 2 * sizeof(float));
+    put16(f, 2 * sizeof(float));
+    put16(f, 32);
+    fwrite("data", 1, 4, f);
+    put32(f, dataBytes);
+    for (int i = 0; i < b.frames(); i++) {
+        const float frame[2] = {b.left[i], b.right[i]};
+        fwrite(frame, sizeof(float), 2, f);
+    }
+    return fclose(f) == 0;
+}
+
+int main(int argc, char *argv[])
+{
+    std::vector<float> offsets = {1.0f}, bpms = {BPM};
+    double sampleRate = 48000.;
+    int threads = 0;
+    std::string dir = ".";
+    bool verify = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--offset") == 0 && i + 1 < argc) {
+            offsets = parseList(argv[++i]);
+        } else if (strcmp(argv[i], "--bpm") == 0 && i + 1 < argc) {
+            bpms = parseList(argv[++i]);
+        } else if (strcmp(argv[i], "--rate") == 0 && i + 1 < argc) {
+            sampleRate = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            dir = argv[++i];
+        } else if (strcmp(argv[i], "--verify") == 0) {
+            verify = true;
+        } else {
+            printf("unknown option %s\n", argv[i]);
+            return 1;
+        }
+    }
+    gam::sampleRate(sampleRate);
+
+    std::vector<ScoreRender> renders;
+    for (float offset : offsets) {
+        for (float bpm : bpms) {
+            ScoreRender r;
+            r.offset = offset;
+            r.bpm = bpm;
+            renders.push_back(r);
+        }
+    }
+
+    ParallelRenderer renderer(sampleRate, threads);
+    auto start = Clock::now();
+    renderer.render(renders);
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+    printf("%d renders, %d phrases each, on %d threads: %.2f s\n", (int)renders.size(), kNumPhrases,
+           renderer.threads(), elapsed.count());
+
+    int failed = 0;
+    if (verify) {
+        std::vector<ScoreRender> reference(renders.size());
+        for (size_t i = 0; i < renders.size(); i++) {
+            reference[i].offset = renders[i].offset;
+            reference[i].bpm = renders[i].bpm;
+        }
+        ParallelRenderer(sampleRate, 1).render(reference);
+        for (size_t i = 0; i < renders.size(); i++) {
+            const StereoBuffer &a = renders[i].out, &b = reference[i].out;
+            if (a.frames() != b.frames() ||
+                memcmp(a.left.data(), b.left.data(), a.frames() * sizeof(float)) != 0 ||
+                memcmp(a.right.data(), b.right.data(), a.frames() * sizeof(float)) != 0) {
+                printf("offset %g, %g bpm differs from the single-threaded render\n",
+                       renders[i].offset, renders[i].bpm);
+                failed++;
+            }
+        }
+        printf("verify: %d of %d renders identical to one thread\n",
+               (int)renders.size() - failed, (int)renders.size());
+    }
+
+    for (auto &r : renders) {
+        char name[64];
+        snprintf(name, sizeof(name), "/score-%g-%gbpm.wav", r.offset, r.bpm);
+        if (!writeWav(dir + name, r.out, sampleRate)) {
+            printf("can't write %s%s\n", dir.c_str(), name);
+            failed++;
+        }
+    }
+    return failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,42 @@
+#include <chrono>
+#include <cstdio>
+
+#include <sys/resource.h>
+
+#include "ResourceUsage.hpp"
+
+namespace {
+    double wallSeconds()
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    double seconds(const timeval &t) { return t.tv_sec + t.tv_usec * 1e-6; }
+}
+
+void ResourceUsage::mark()
+{
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    mWall = wallSeconds();
+    mUser = seconds(usage.ru_utime);
+    mSystem = seconds(usage.ru_stime);
+}
+
+std::string ResourceUsage::report() const
+{
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    const double wall = wallSeconds() - mWall;
+    const double user = seconds(usage.ru_utime) - mUser;
+    const double system = seconds(usage.ru_stime) - mSystem;
+#if defined(__APPLE__)
+    const double rssMb = usage.ru_maxrss / 1048576.0; // bytes
+#else
+    const double rssMb = usage.ru_maxrss / 1024.0;    // kilobytes
+#endif
+    char line[160];
+    snprintf(line, sizeof(line), "cpu %.1f%% (user %.1f s, system %.1f s over %.1f s), max rss %.1f MB",
+             wall > 0 ? 100.0 * (user + system) / wall : 0.0, user, system, wall, rssMb);
+    return line;
+}
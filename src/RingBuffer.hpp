@@ -0,0 +1,76 @@
+#ifndef RINGBUFFER_HPP
+#define RINGBUFFER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+// Lock-free ring buffer for one producer thread and one consumer thread.
+// Neither side ever blocks or allocates: the producer writes into free
+// slots and publishes them with commitWrite(), the consumer copies out
+// what has been published with read(). Capacity is rounded up to a power
+// of two, and resize() must only be called while neither side is running.
+template <class T>
+class RingBuffer {
+    public:
+        explicit RingBuffer(size_t capacity = 0) { resize(capacity); }
+
+        void resize(size_t capacity) {
+            size_t n = 1;
+            while (n < capacity) {
+                n <<= 1;
+            }
+            mBuffer.assign(capacity ? n : 0, T());
+            mMask = capacity ? n - 1 : 0;
+            mWrite = 0;
+            mRead = 0;
+        }
+
+        size_t capacity() const { return mBuffer.size(); }
+
+        // Producer side
+        size_t writeAvailable() const {
+            return capacity() - (mWrite.load(std::memory_order_relaxed) -
+                                 mRead.load(std::memory_order_acquire));
+        }
+        // Slot i past the write position; i < writeAvailable()
+        T &writeSlot(size_t i) { return mBuffer[(mWrite.load(std::memory_order_relaxed) + i) & mMask]; }
+        void commitWrite(size_t n) { mWrite.store(mWrite.load(std::memory_order_relaxed) + n, std::memory_order_release); }
+
+        bool write(const T *data, size_t n) {
+            if (n > writeAvailable()) {
+                return false;
+            }
+            for (size_t i = 0; i < n; i++) {
+                writeSlot(i) = data[i];
+            }
+            commitWrite(n);
+            return true;
+        }
+
+        // Consumer side
+        size_t readAvailable() const {
+            return mWrite.load(std::memory_order_acquire) - mRead.load(std::memory_order_relaxed);
+        }
+
+        // Copy up to n items out, returning how many were read
+        size_t read(T *out, size_t n) {
+            n = std::min(n, readAvailable());
+            const size_t start = mRead.load(std::memory_order_relaxed);
+            const size_t first = std::min(n, capacity() - (start & mMask));
+            std::copy_n(mBuffer.begin() + (start & mMask), first, out);
+            std::copy_n(mBuffer.begin(), n - first, out + first);
+            mRead.store(start + n, std::memory_order_release);
+            return n;
+        }
+
+    private:
+        std::vector<T> mBuffer;
+        size_t mMask = 0;
+        // Free-running positions; only their difference wraps
+        alignas(64) std::atomic<size_t> mWrite{0};
+        alignas(64) std::atomic<size_t> mRead{0};
+};
+
+#endif
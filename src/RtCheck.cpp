@@ -0,0 +1,230 @@
+/*
+Real-time safety check for the audio paths. Built with -DRT_SAFETY_CHECK=ON
+(see RtSafety.hpp): drives each path block by block without an audio
+device, with the same RT_SAFETY_SCOPE the app's onSound opens, and prints
+a stack trace for every allocation or mutex lock made inside it.
+
+Usage: rtcheck [name ...]    (no names runs every path)
+  score       ScorePlayer playback, as the app's key press does
+  sequencer   MyApp::playNote scheduling from the audio thread (stress mode)
+  subblocks   the app's sub-block and mix graph rendering; also checks that
+              the sequencer clock advances by exactly one device block
+  osc         notes triggered from the OSC receive thread while rendering
+
+Exits 1 if any path was flagged or failed a check.
+*/
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "Gamma/Domain.h"
+
+#include "al/protocol/al_OSC.hpp"
+#include "al/scene/al_SynthSequencer.hpp"
+
+#include "AudioProfile.hpp"
+#include "MixGraph.hpp"
+#include "RtSafety.hpp"
+#include "Score.hpp"
+#include "ScorePlayer.hpp"
+#include "SineEnv.hpp"
+
+const double kSampleRate = 48000.;
+const int kBlockSize = 512;
+const int kSubBlockSize = 64;
+
+int failedChecks = 0;
+
+// Render blocks until done() says so, each inside an audio scope
+template <class BlockFunc>
+void renderBlocks(AudioIOData &io, int maxBlocks, BlockFunc &&block)
+{
+    for (int b = 0; b < maxBlocks; b++) {
+        io.zeroOut();
+        io.frame(0);
+        RT_SAFETY_SCOPE("onSound");
+        if (!block(b)) {
+            break;
+        }
+    }
+}
+
+void makeDevice(AudioIOData &io)
+{
+    io.framesPerSecond(kSampleRate);
+    io.framesPerBuffer(kBlockSize);
+    io.channels(2, true);
+}
+
+void checkScore()
+{
+    AudioIOData io;
+    makeDevice(io);
+    PolySynth synth;
+    ScorePlayer player;
+    player.compileAsync(1.0, BPM, kSampleRate);
+    while (!player.prepare<SineEnv>(synth)) {
+        al::wait(0.01);
+    }
+
+    player.retrigger();
+    const int blocks = (int)(kSampleRate * 60.0 / kBlockSize); // the first minute
+    renderBlocks(io, blocks, [&](int) {
+        player.process<SineEnv>(io, synth);
+        synth.render(io);
+        return true;
+    });
+}
+
+void checkSequencer()
+{
+    AudioIOData io;
+    makeDevice(io);
+    SynthSequencer sequencer;
+    sequencer.synth().allocatePolyphony<SineEnv>(64);
+
+    renderBlocks(io, 400, [&](int b) {
+        // One note every other block, the way stress mode adds voices
+        if (b % 2 == 0 && b < 200) {
+            SynthVoice *voice = sequencer.synth().getVoice<SineEnv>();
+            voice->setInternalParameterValue("amplitude", 0.1);
+            voice->setInternalParameterValue("frequency", 110 + b);
+            voice->setInternalParameterValue("attackTime", 0.01);
+            voice->setInternalParameterValue("releaseTime", 0.05);
+            voice->setInternalParameterValue("pan", 0.0);
+            sequencer.addVoiceFromNow(voice, 0, 0.1);
+        }
+        sequencer.render(io);
+        return true;
+    });
+}
+
+void checkSubBlocks()
+{
+    AudioIOData io;
+    makeDevice(io);
+    SynthSequencer sequencer;
+    sequencer.synth().allocatePolyphony<SineEnv>(16);
+    SubBlockRenderer subBlocks;
+    subBlocks.configure(kSubBlockSize, kSampleRate, io.channelsOut());
+    MixGraph mix;
+    mix.configure(io.channelsOut(), kBlockSize, kSampleRate);
+    const int bus = mix.addBus("voices");
+
+    const double blockSeconds = kBlockSize / kSampleRate;
+    renderBlocks(io, 200, [&](int b) {
+        const double start = sequencer.getCurrentTime();
+        subBlocks.render(io, [&](AudioIOData &block) {
+            mix.beginBlock(block.framesPerBuffer());
+            mix.renderGroup(bus, [&](AudioIOData &group) { sequencer.render(group); });
+            mix.process(block);
+        });
+        const double advanced = sequencer.getCurrentTime() - start;
+        if (std::fabs(advanced - blockSeconds) > 1e-9) {
+            printf("subblocks: block %d advanced the sequencer %.6f s, expected %.6f s\n", b, advanced,
+                   blockSeconds);
+            failedChecks++;
+            return false;
+        }
+        return true;
+    });
+}
+
+void checkOsc()
+{
+    const unsigned short port = 16449;
+
+    struct Handler : public osc::PacketHandler {
+        PolySynth *synth;
+        std::atomic<int> count{0};
+        void onMessage(osc::Message &m) override {
+            if (m.addressPattern() == "/note" && m.typeTags() == "if") {
+                int id;
+                float freq;
+                m >> id >> freq;
+                if (freq > 0) {
+                    SineEnv *voice = synth->getVoice<SineEnv>();
+                    voice->setInternalParameterValue("frequency", freq);
+                    synth->triggerOn(voice, 0, id);
+                } else {
+                    synth->triggerOff(id);
+                }
+            }
+            count++;
+        }
+    } handler;
+
+    AudioIOData io;
+    makeDevice(io);
+    PolySynth synth;
+    synth.allocatePolyphony<SineEnv>(64);
+    handler.synth = &synth;
+
+    osc::Recv server;
+    if (!server.open(port, "localhost", 0.001)) {
+        printf("osc: can't open port %d, skipped\n", port);
+        return;
+    }
+    server.handler(handler);
+    server.start();
+    osc::Send client;
+    client.open(port, "localhost");
+
+    const int numNotes = 32;
+    renderBlocks(io, 2000, [&](int b) {
+        if (b < numNotes * 2) {
+            client.send("/note", b / 2, b % 2 == 0 ? 220.f + b : 0.f);
+        }
+        synth.render(io);
+        return b < numNotes * 2 || handler.count < numNotes * 2;
+    });
+    server.stop();
+}
+
+struct Check {
+    const char *name;
+    void (*run)();
+};
+
+const Check checks[] = {
+    {"score", checkScore},
+    {"sequencer", checkSequencer},
+    {"subblocks", checkSubBlocks},
+    {"osc", checkOsc},
+};
+
+int main(int argc, char *argv[])
+{
+    gam::sampleRate(kSampleRate);
+
+    int flagged = 0;
+    for (auto &c : checks) {
+        bool selected = argc < 2;
+        for (int i = 1; i < argc; i++) {
+            if (strcmp(argv[i], c.name) == 0) {
+                selected = true;
+            }
+        }
+        if (!selected) {
+            continue;
+        }
+        rtsafety::clear();
+        const int failedBefore = failedChecks;
+        c.run();
+        printf("%-10s %d calls flagged\n", c.name, rtsafety::violations());
+        if (failedChecks > failedBefore) {
+            flagged++;
+        }
+        if (rtsafety::violations() > 0) {
+            flagged++;
+            rtsafety::report(stdout);
+            printf("\n");
+        }
+    }
+    return flagged > 0 ? 1 : 0;
+}
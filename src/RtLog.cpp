@@ -0,0 +1,265 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include <pthread.h>
+
+#include "RingBuffer.hpp"
+#include "RtLog.hpp"
+
+namespace rtlog {
+
+    namespace {
+        const int kMaxThreads = 32;
+        const size_t kRingRecords = 1024; // 128 kB a thread
+
+        const char *const kCategoryNames[kNumCategories] = {"audio", "osc", "score", "record", "system"};
+        const char *const kLevelNames[kOff + 1] = {"debug", "info", "warn", "error", "off"};
+
+        // A slot is claimed by a thread's first log call and handed back
+        // when the thread exits; the writer drains what is left in its ring
+        // before it can be claimed again
+        enum SlotState { kFree, kOwned, kExited };
+
+        struct ThreadLog {
+            RingBuffer<Record> ring;
+            std::atomic<int> state{kFree};
+            std::atomic<uint64_t> dropped{0};
+            uint64_t reported = 0; // writer thread only
+            char name[16] = {};
+            std::atomic<bool> named{false}; // name is written and may be read
+        };
+
+        // Rings are allocated once by start() and then only claimed
+        ThreadLog gThreads[kMaxThreads];
+        std::atomic<bool> gRunning{false};
+        std::atomic<uint64_t> gUnowned{0}; // from threads while every slot is owned
+        std::atomic<uint8_t> gLevels[kNumCategories] = {{kInfo}, {kInfo}, {kInfo}, {kInfo}, {kInfo}};
+        std::thread gWriter;
+        FILE *gOut = stdout;
+        int64_t gStartNs = 0;
+
+        thread_local int tSlot = -1;
+
+        // Returns the slot when its thread exits. A pthread key rather than
+        // a thread_local destructor, whose registration allocates on the
+        // thread's first log call; this key's value lives in the thread's
+        // preallocated first block.
+        pthread_key_t gSlotKey;
+        pthread_once_t gSlotKeyOnce = PTHREAD_ONCE_INIT;
+
+        void releaseSlot(void *slot) {
+            gThreads[(intptr_t)slot - 1].state.store(kExited, std::memory_order_release);
+        }
+
+        void createSlotKey() { pthread_key_create(&gSlotKey, releaseSlot); }
+
+        ThreadLog *threadLog() {
+            if (tSlot < 0) {
+                pthread_once(&gSlotKeyOnce, createSlotKey);
+                for (int t = 0; t < kMaxThreads; t++) {
+                    int expected = kFree;
+                    if (gThreads[t].state.compare_exchange_strong(expected, kOwned, std::memory_order_acq_rel)) {
+                        tSlot = t;
+                        pthread_setspecific(gSlotKey, (void *)(intptr_t)(t + 1));
+                        break;
+                    }
+                }
+            }
+            return tSlot >= 0 ? &gThreads[tSlot] : nullptr;
+        }
+
+        void format(const Record &r, const char *thread, std::string &line) {
+            char buffer[64];
+            snprintf(buffer, sizeof(buffer), "[%10.3f %-6s %-5s %s] ", (r.timeNs - gStartNs) / 1e9,
+                     kCategoryNames[r.category], kLevelNames[r.level], thread);
+            line = buffer;
+            int arg = 0;
+            for (const char *c = r.format; *c; c++) {
+                if (c[0] != '{' || c[1] != '}' || arg >= r.numArgs) {
+                    line += *c;
+                    continue;
+                }
+                switch (r.types[arg]) {
+                    case 'i':
+                        snprintf(buffer, sizeof(buffer), "%lld", (long long)r.args[arg].i);
+                        break;
+                    case 'u':
+                        snprintf(buffer, sizeof(buffer), "%llu", (unsigned long long)r.args[arg].u);
+                        break;
+                    case 'f':
+                        snprintf(buffer, sizeof(buffer), "%g", r.args[arg].f);
+                        break;
+                    default:
+                        buffer[0] = '\0';
+                        line += r.text + r.args[arg].text;
+                        break;
+                }
+                line += buffer;
+                arg++;
+                c++;
+            }
+            line += '\n';
+        }
+
+        // Write everything queued so far, then any new drop counts
+        void drain() {
+            Record records[64];
+            std::string line;
+            for (int t = 0; t < kMaxThreads; t++) {
+                ThreadLog &log = gThreads[t];
+                const int state = log.state.load(std::memory_order_acquire);
+                if (state == kFree) {
+                    continue;
+                }
+                char name[16];
+                if (log.named.load(std::memory_order_acquire)) {
+                    memcpy(name, log.name, sizeof(name));
+                } else {
+                    snprintf(name, sizeof(name), "t%d", t);
+                }
+                size_t n;
+                while ((n = log.ring.read(records, 64)) > 0) {
+                    for (size_t i = 0; i < n; i++) {
+                        format(records[i], name, line);
+                        fputs(line.c_str(), gOut);
+                    }
+                }
+                const uint64_t dropped = log.dropped.load();
+                if (dropped != log.reported) {
+                    fprintf(gOut, "rtlog: %llu records dropped on %s (ring full)\n",
+                            (unsigned long long)(dropped - log.reported), name);
+                    log.reported = dropped;
+                }
+                // Its thread is gone and the ring is empty: free for the next one
+                if (state == kExited) {
+                    log.named.store(false, std::memory_order_relaxed);
+                    log.state.store(kFree, std::memory_order_release);
+                }
+            }
+            fflush(gOut);
+        }
+    }
+
+    void setLevel(Category c, Level l) { gLevels[c].store((uint8_t)l, std::memory_order_relaxed); }
+    Level level(Category c) { return (Level)gLevels[c].load(std::memory_order_relaxed); }
+    bool enabled(Category c, Level l) { return l >= level(c) && l != kOff; }
+
+    bool parseLevels(const char *spec)
+    {
+        std::string s(spec);
+        size_t start = 0;
+        while (start <= s.size()) {
+            size_t end = s.find(',', start);
+            if (end == std::string::npos) {
+                end = s.size();
+            }
+            const std::string item = s.substr(start, end - start);
+            const size_t eq = item.find('=');
+            const std::string category = eq == std::string::npos ? "" : item.substr(0, eq);
+            const std::string name = eq == std::string::npos ? item : item.substr(eq + 1);
+            int l = 0;
+            while (l <= kOff && name != kLevelNames[l]) {
+                l++;
+            }
+            if (l > kOff) {
+                return false;
+            }
+            bool found = false;
+            for (int c = 0; c < kNumCategories; c++) {
+                if (category.empty() || category == kCategoryNames[c]) {
+                    setLevel((Category)c, (Level)l);
+                    found = true;
+                }
+            }
+            if (!found) {
+                return false;
+            }
+            start = end + 1;
+        }
+        return true;
+    }
+
+    const char *usage()
+    {
+        return "--log LEVELS (debug|info|warn|error|off, for all or per category: "
+               "audio, osc, score, record, system; e.g. osc=debug,audio=warn)";
+    }
+
+    void threadName(const char *name)
+    {
+        ThreadLog *log = threadLog();
+        if (log && !log->named.load(std::memory_order_relaxed)) {
+            strncpy(log->name, name, sizeof(log->name) - 1);
+            log->named.store(true, std::memory_order_release);
+        }
+    }
+
+    void start(FILE *out, double periodMs)
+    {
+        if (gRunning) {
+            return;
+        }
+        gOut = out;
+        gStartNs = detail::nowNs();
+        for (ThreadLog &log : gThreads) {
+            if (log.ring.capacity() == 0) {
+                log.ring.resize(kRingRecords);
+            }
+        }
+        gRunning = true;
+        gWriter = std::thread([periodMs] {
+            threadName("rtlog");
+            const auto period = std::chrono::microseconds((int64_t)(periodMs * 1000));
+            while (gRunning) {
+                std::this_thread::sleep_for(period);
+                drain();
+            }
+            drain();
+        });
+    }
+
+    void stop()
+    {
+        if (!gRunning.exchange(false)) {
+            return;
+        }
+        gWriter.join();
+        if (gUnowned > 0) {
+            fprintf(gOut, "rtlog: %llu records dropped from threads beyond %d logging at once\n",
+                    (unsigned long long)gUnowned.load(), kMaxThreads);
+        }
+    }
+
+    uint64_t dropped()
+    {
+        uint64_t total = gUnowned;
+        for (const ThreadLog &log : gThreads) {
+            total += log.dropped;
+        }
+        return total;
+    }
+
+    void push(const Record &r)
+    {
+        ThreadLog *log = threadLog();
+        if (!log) {
+            gUnowned++;
+            return;
+        }
+        // Before start() the rings are empty and everything counts as dropped
+        if (!log->ring.write(&r, 1)) {
+            log->dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    int64_t detail::nowNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+}
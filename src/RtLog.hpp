@@ -0,0 +1,140 @@
+#ifndef RTLOG_HPP
+#define RTLOG_HPP
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <type_traits>
+
+// Logging that the audio and network threads can leave on in production.
+// A log call checks its category's level, packs the format pointer and up
+// to four arguments into a fixed-size record and pushes it onto a ring
+// owned by the calling thread: no locks, no allocation, no I/O. A
+// background thread started with start() formats and writes the records;
+// a full ring drops the record and counts it, and the counts are reported
+// with the output.
+//
+//     rtlog::info(rtlog::kOsc, "note {} at {} Hz", id, freq);
+//
+// Formats must be string literals; each {} takes the next argument.
+// String arguments are copied into the record, truncated to fit.
+namespace rtlog {
+
+    enum Category { kAudio, kOsc, kScore, kRecord, kSystem, kNumCategories };
+    enum Level { kDebug, kInfo, kWarn, kError, kOff };
+
+    struct Record {
+        static const int kMaxArgs = 4;
+        static const int kTextSize = 72;
+
+        int64_t timeNs;
+        const char *format;
+        uint8_t category;
+        uint8_t level;
+        uint8_t numArgs;
+        char types[kMaxArgs]; // 'i', 'u', 'f' or 's'
+        union {
+            int64_t i;
+            uint64_t u;
+            double f;
+            uint32_t text; // offset into text
+        } args[kMaxArgs];
+        char text[kTextSize];
+        uint32_t textUsed;
+    };
+
+    // Per-category thresholds; records below them are never built
+    void setLevel(Category c, Level l);
+    Level level(Category c);
+    bool enabled(Category c, Level l);
+    // e.g. "osc=debug,audio=warn" or just "debug" for every category
+    bool parseLevels(const char *spec);
+    const char *usage();
+
+    // Name the calling thread in the output, e.g. "audio". Only the first
+    // name a thread gives takes effect.
+    void threadName(const char *name);
+
+    // Start or stop the writer thread. stop() writes what is left.
+    void start(FILE *out = stdout, double periodMs = 20);
+    void stop();
+
+    // Records dropped because a ring was full, or a thread had no ring
+    // (more than 32 threads logging at once; a thread's ring is freed
+    // when it exits)
+    uint64_t dropped();
+
+    void push(const Record &r);
+
+    namespace detail {
+        // Strings past the end of text come out empty
+        inline void packText(Record &r, int n, const char *s) {
+            uint32_t end = r.textUsed;
+            r.types[n] = 's';
+            r.args[n].text = end;
+            while (s && *s && end < Record::kTextSize - 1) {
+                r.text[end++] = *s++;
+            }
+            r.text[end] = '\0';
+            r.textUsed = end + 1 < Record::kTextSize ? end + 1 : Record::kTextSize - 1;
+        }
+        inline void packArg(Record &r, int n, const char *s) { packText(r, n, s); }
+        inline void packArg(Record &r, int n, const std::string &s) { packText(r, n, s.c_str()); }
+        template <class T>
+        typename std::enable_if<std::is_floating_point<T>::value>::type packArg(Record &r, int n, T v) {
+            r.types[n] = 'f';
+            r.args[n].f = v;
+        }
+        template <class T>
+        typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type
+        packArg(Record &r, int n, T v) {
+            r.types[n] = 'i';
+            r.args[n].i = v;
+        }
+        template <class T>
+        typename std::enable_if<std::is_integral<T>::value && !std::is_signed<T>::value>::type
+        packArg(Record &r, int n, T v) {
+            r.types[n] = 'u';
+            r.args[n].u = v;
+        }
+
+        inline void pack(Record &, int) {}
+
+        template <class T, class... Rest>
+        void pack(Record &r, int n, const T &value, const Rest &... rest) {
+            packArg(r, n, value);
+            pack(r, n + 1, rest...);
+        }
+
+        int64_t nowNs();
+    }
+
+    template <class... Args>
+    void log(Category c, Level l, const char *format, const Args &... args) {
+        static_assert(sizeof...(Args) <= Record::kMaxArgs, "rtlog records hold four arguments");
+        if (!enabled(c, l)) {
+            return;
+        }
+        Record r;
+        r.timeNs = detail::nowNs();
+        r.format = format;
+        r.category = (uint8_t)c;
+        r.level = (uint8_t)l;
+        r.numArgs = (uint8_t)sizeof...(Args);
+        r.textUsed = 0;
+        detail::pack(r, 0, args...);
+        push(r);
+    }
+
+    template <class... Args>
+    void debug(Category c, const char *format, const Args &... args) { log(c, kDebug, format, args...); }
+    template <class... Args>
+    void info(Category c, const char *format, const Args &... args) { log(c, kInfo, format, args...); }
+    template <class... Args>
+    void warn(Category c, const char *format, const Args &... args) { log(c, kWarn, format, args...); }
+    template <class... Args>
+    void error(Category c, const char *format, const Args &... args) { log(c, kError, format, args...); }
+
+}
+
+#endif
@@ -0,0 +1,216 @@
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <vector>
+
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <pthread.h>
+
+#include "RtSafety.hpp"
+
+namespace {
+    const int kMaxRecords = 256;
+    const int kMaxFrames = 32;
+
+    struct Record {
+        const char *call;
+        const char *where;
+        void *frames[kMaxFrames];
+        int depth;
+    };
+
+    Record records[kMaxRecords];
+    std::atomic<int> numRecords{0};
+    std::atomic<int> numViolations{0};
+
+    // Plain data only, so reading them never allocates
+    thread_local int tDepth = 0;
+    thread_local const char *tWhere = nullptr;
+    thread_local bool tInCheck = false;
+
+    void check(const char *call)
+    {
+        if (tDepth == 0 || tInCheck) {
+            return;
+        }
+        tInCheck = true;
+        numViolations.fetch_add(1, std::memory_order_relaxed);
+        const int slot = numRecords.fetch_add(1, std::memory_order_relaxed);
+        if (slot < kMaxRecords) {
+            Record &r = records[slot];
+            r.call = call;
+            r.where = tWhere;
+            r.depth = backtrace(r.frames, kMaxFrames);
+        }
+        tInCheck = false;
+    }
+
+    // backtrace() loads libgcc on first use, which allocates; do that now
+    struct Warmup {
+        Warmup() {
+            void *frames[2];
+            backtrace(frames, 2);
+        }
+    } warmup;
+}
+
+rtsafety::Scope::Scope(const char *where)
+{
+    if (tDepth++ == 0) {
+        tWhere = where;
+    }
+}
+
+rtsafety::Scope::~Scope() { tDepth--; }
+
+int rtsafety::violations() { return numViolations; }
+
+void rtsafety::clear()
+{
+    numViolations = 0;
+    numRecords = 0;
+}
+
+void rtsafety::report(FILE *out, int maxTraces)
+{
+    const int n = std::min((int)numRecords, kMaxRecords);
+    // Group identical traces; skip the first frame, which is check()
+    std::vector<std::pair<int, int>> groups; // count, first record
+    for (int i = 0; i < n; i++) {
+        bool found = false;
+        for (auto &g : groups) {
+            const Record &a = records[g.second];
+            if (a.depth == records[i].depth && a.call == records[i].call &&
+                memcmp(a.frames + 1, records[i].frames + 1, (a.depth - 1) * sizeof(void *)) == 0) {
+                g.first++;
+                found = true;
+                break;
+            }
+        }
+        if (!found) {
+            groups.push_back({1, i});
+        }
+    }
+    std::stable_sort(groups.begin(), groups.end(),
+                     [](const std::pair<int, int> &a, const std::pair<int, int> &b) { return a.first > b.first; });
+
+    fprintf(out, "rt safety: %d calls flagged, %d distinct\n", (int)numViolations, (int)groups.size());
+    for (int g = 0; g < (int)groups.size() && g < maxTraces; g++) {
+        const Record &r = records[groups[g].second];
+        fprintf(out, "\n%s in %s (%d times):\n", r.call, r.where ? r.where : "?", groups[g].first);
+        fflush(out);
+        backtrace_symbols_fd(r.frames + 1, r.depth - 1, fileno(out));
+    }
+}
+
+#if defined(__GLIBC__)
+
+// The replacements forward to glibc's own entry points, which never go
+// back through the symbols defined here.
+extern "C" {
+    void *__libc_malloc(size_t size);
+    void *__libc_calloc(size_t count, size_t size);
+    void *__libc_realloc(void *p, size_t size);
+    void *__libc_memalign(size_t alignment, size_t size);
+    void __libc_free(void *p);
+
+    void *malloc(size_t size)
+    {
+        check("malloc");
+        return __libc_malloc(size);
+    }
+
+    void *calloc(size_t count, size_t size)
+    {
+        check("calloc");
+        return __libc_calloc(count, size);
+    }
+
+    void *realloc(void *p, size_t size)
+    {
+        check("realloc");
+        return __libc_realloc(p, size);
+    }
+
+    int posix_memalign(void **p, size_t alignment, size_t size)
+    {
+        check("posix_memalign");
+        *p = __libc_memalign(alignment, size);
+        return *p ? 0 : ENOMEM;
+    }
+
+    void free(void *p)
+    {
+        if (p) {
+            check("free");
+        }
+        __libc_free(p);
+    }
+
+    int pthread_mutex_lock(pthread_mutex_t *mutex)
+    {
+        typedef int (*LockFunc)(pthread_mutex_t *);
+        static LockFunc real = (LockFunc)dlsym(RTLD_NEXT, "pthread_mutex_lock");
+        check("pthread_mutex_lock");
+        return real(mutex);
+    }
+}
+
+void *operator new(size_t size)
+{
+    check("operator new");
+    void *p = __libc_malloc(size ? size : 1);
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void *operator new[](size_t size)
+{
+    check("operator new[]");
+    void *p = __libc_malloc(size ? size : 1);
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept
+{
+    check("operator new");
+    return __libc_malloc(size ? size : 1);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept
+{
+    check("operator new[]");
+    return __libc_malloc(size ? size : 1);
+}
+
+void operator delete(void *p) noexcept
+{
+    if (p) {
+        check("operator delete");
+    }
+    __libc_free(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+    if (p) {
+        check("operator delete[]");
+    }
+    __libc_free(p);
+}
+
+void operator delete(void *p, size_t) noexcept { operator delete(p); }
+void operator delete[](void *p, size_t) noexcept { operator delete[](p); }
+
+#else
+#warning "RT_SAFETY_CHECK only interposes allocation and locking on glibc; scopes will not flag anything"
+#endif
@@ -0,0 +1,36 @@
+#ifndef RTSAFETY_HPP
+#define RTSAFETY_HPP
+
+#include <cstdio>
+
+// Debug check that nothing on the audio thread allocates or takes a lock.
+// Built with -DRT_SAFETY_CHECK=ON, RtSafety.cpp replaces malloc, free,
+// operator new/delete and pthread_mutex_lock; any call made while an
+// RT_SAFETY_SCOPE is open on the calling thread is recorded with its
+// stack trace. Without the option the scopes compile to nothing.
+//
+// Recording never allocates, so the audio thread only pays for a
+// backtrace() when it already did something it shouldn't have.
+namespace rtsafety {
+
+    class Scope {
+        public:
+            explicit Scope(const char *where);
+            ~Scope();
+    };
+
+    // Calls flagged since startup or the last clear()
+    int violations();
+    void clear();
+    // Print the distinct stack traces recorded, most frequent first
+    void report(FILE *out = stderr, int maxTraces = 10);
+
+}
+
+#ifdef RT_SAFETY_CHECK
+#define RT_SAFETY_SCOPE(where) rtsafety::Scope rtSafetyScope_(where)
+#else
+#define RT_SAFETY_SCOPE(where) ((void)0)
+#endif
+
+#endif
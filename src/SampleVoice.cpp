@@ -0,0 +1,34 @@
+#include <algorithm>
+
+#include "SampleVoice.hpp"
+
+void SampleVoice::onProcess(AudioIOData &io)
+{
+    const int remaining = mBuffer ? mBuffer->frames() - mPos : 0;
+    const int start = io.frame() + 1;
+    const int n = std::min(remaining, (int)io.framesPerBuffer() - start);
+    if (n > 0) {
+        const float *l = mBuffer->left.data() + mPos;
+        const float *r = mBuffer->right.data() + mPos;
+        const SpeakerLayout *layout = SpeakerLayout::current();
+        if (layout && io.channelsOut() > 2) {
+            mSpatialL.layout(layout);
+            mSpatialR.layout(layout);
+            mSpatialL.position(-30.f);
+            mSpatialR.position(30.f);
+            mSpatialL.mix(l, n, io, start);
+            mSpatialR.mix(r, n, io, start);
+        } else {
+            float *outL = io.outBuffer(0) + start;
+            float *outR = io.outBuffer(1) + start;
+            for (int i = 0; i < n; i++) {
+                outL[i] += l[i];
+                outR[i] += r[i];
+            }
+        }
+        mPos += n;
+    }
+    if (n <= 0 || mPos >= mBuffer->frames()) {
+        free();
+    }
+}
@@ -0,0 +1,45 @@
+#ifndef SAMPLEVOICE_HPP
+#define SAMPLEVOICE_HPP
+
+#include <memory>
+
+#include "al/scene/al_PolySynth.hpp"
+
+#include "OfflineRender.hpp"
+#include "Spatializer.hpp"
+
+using namespace al;
+
+// Plays a pre-rendered stereo buffer once, from the start, and frees
+// itself at the end. Set the buffer before scheduling the voice; many
+// voices can share one buffer. With more than two outputs, the left and
+// right channels are spatialized as a pair of sources at -30 and +30
+// degrees.
+class SampleVoice : public SynthVoice {
+    public:
+        void buffer(std::shared_ptr<const StereoBuffer> b) { mBuffer = std::move(b); }
+
+        // Both spatializers are sized before the voice ever plays
+        void init() override {
+            mSpatialL.layout(SpeakerLayout::current());
+            mSpatialR.layout(SpeakerLayout::current());
+        }
+
+        void onProcess(AudioIOData& io) override;
+
+        void onTriggerOn() override {
+            mPos = 0;
+            mSpatialL.reset();
+            mSpatialR.reset();
+        }
+        // Plays to the end; the release tail is already in the buffer
+        void onTriggerOff() override {}
+
+    private:
+        std::shared_ptr<const StereoBuffer> mBuffer;
+        int mPos = 0;
+        Spatializer mSpatialL;
+        Spatializer mSpatialR;
+};
+
+#endif
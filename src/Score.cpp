@@ -0,0 +1,616 @@
+#include "notedefs.hpp"
+#include "Score.hpp"
+
+Sequence *sequence(float offset) {
+    TimeSignature t;
+    Sequence *result = new Sequence(t);
+
+    for (int n = 1; n <= kNumPhrases; n++) {
+        Sequence *phrase = sequencePhrase(n, offset);
+        result->addSequence(phrase, phraseStartBeat(n), phraseAmp);
+        delete phrase;
+    }
+
+    return result;
+}
+
+Sequence *sequencePhrase(int n, float offset) {
+    static Sequence *(*const phrases[kNumPhrases])(float) = {
+        sequencePhrase1,
+        sequencePhrase2,
+        sequencePhrase3,
+        sequencePhrase4,
+        sequencePhrase5,
+        sequencePhrase6,
+        sequencePhrase7,
+        sequencePhrase8,
+        sequencePhrase9,
+        sequencePhrase10,
+        sequencePhrase11,
+        sequencePhrase12,
+        sequencePhrase13,
+        sequencePhrase14,
+        sequencePhrase15,
+        sequencePhrase16,
+        sequencePhrase17,
+        sequencePhrase18,
+    };
+    return phrases[n - 1](offset);
+}
+
+float phraseStartBeat(int n) { return dashLength * 27 * (n - 1); }
+
+Sequence *sequencePhrase1(float offset) {
+    TimeSignature t;
+    Sequence *result = new Sequence(t);
+
+    result->add(Note(D5 * offset, dashLength * 0, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D5 * offset, dashLength * 6, dottedHalfNote / 1000.f, amplitude, dottedHalfNote, dottedHalfNote));
+    result->add(Note(C5 * offset, dashLength * 25, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B4 * offset, dashLength * 3, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B2 * offset, dashLength * 0, wholeNote / 1000.f, amplitude, wholeNote, wholeNote));
+
+    return result;
+}
+
+Sequence *sequencePhrase2(float offset) {
+    TimeSignature t;
+    Sequence *result = new Sequence(t);
+
+    result->add(Note(C5s * offset, dashLength * 4, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D5 * offset, dashLength * 22, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D5 * offset, dashLength * 26, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A4s * offset, dashLength * 2, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B4 * offset, dashLength * 19, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D3 * offset, dashLength * 19, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B2 * offset, dashLength * 22, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+
+    return result;
+}
+
+Sequence *sequencePhrase3(float offset) {
+    TimeSignature t;
+    Sequence *result = new Sequence(t);
+
+    result->add(Note(D5 * offset, dashLength * 2, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D5 * offset, dashLength * 4, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D5 * offset, dashLength * 14, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D5 * offset, dashLength * 17, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D5 * offset, dashLength * 20, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D5 * offset, dashLength * 22, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B4 * offset, dashLength * 5, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B4 * offset, dashLength * 11, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B4 * offset, dashLength * 13, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B4 * offset, dashLength * 23, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D3 * offset, dashLength * 23, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B2 * offset, dashLength * 23, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+
+    return result;
+}
+
+Sequence *sequencePhrase4(float offset) {
+    TimeSignature t;
+    Sequence *result = new Sequence(t);
+
+    result->add(Note(C5s * offset, dashLength * 6, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(C5s * offset, dashLength * 9, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(C5s * offset, dashLength * 12, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(C5s * offset, dashLength * 14, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(C5s * offset, dashLength * 24, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B4 * offset, dashLength * 3, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B4 * offset, dashLength * 5, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A4s * offset, dashLength * 15, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A4s * offset, dashLength * 21, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A4s * offset, dashLength * 24, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A3s * offset, dashLength * 15, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(C3s * offset, dashLength * 6, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(C3s * offset, dashLength * 12, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(C3s * offset, dashLength * 15, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(C3s * offset, dashLength * 24, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A2s * offset, dashLength * 6, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A2s * offset, dashLength * 12, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A2s * offset, dashLength * 24, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+
+    return result;
+}
+
+Sequence *sequencePhrase5(float offset) {
+    TimeSignature t;
+    Sequence *result = new Sequence(t);
+
+    result->add(Note(C5s * offset, dashLength * 1, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(C5s * offset, dashLength * 4, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(C5s * offset, dashLength * 6, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D5 * offset, dashLength * 16, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D5 * offset, dashLength * 19, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D5 * offset, dashLength * 22, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D5 * offset, dashLength * 24, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A4 * offset, dashLength * 7, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A4 * offset, dashLength * 13, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B4 * offset, dashLength * 25, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D4 * offset, dashLength * 25, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A3s * offset, dashLength * 7, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B3 * offset, dashLength * 16, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B3 * offset, dashLength * 22, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B3 * offset, dashLength * 25, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(C3s * offset, dashLength * 4, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(C3s * offset, dashLength * 7, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D3 * offset, dashLength * 16, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D3 * offset, dashLength * 22, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D3 * offset, dashLength * 25, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A2s * offset, dashLength * 4, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B2 * offset, dashLength * 16, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B2 * offset, dashLength * 22, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+
+    return result;
+}
+
+Sequence *sequencePhrase6(float offset) {
+    TimeSignature t;
+    Sequence *result = new Sequence(t);
+
+    result->add(Note(D5 * offset, dashLength * 8, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D5 * offset, dashLength * 11, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D5 * offset, dashLength * 14, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D5 * offset, dashLength * 16, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B4 * offset, dashLength * 5, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B4 * offset, dashLength * 17, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B4 * offset, dashLength * 23, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B4 * offset, dashLength * 25, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D4 * offset, dashLength * 17, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B3 * offset, dashLength * 8, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B3 * offset, dashLength * 14, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B3 * offset, dashLength * 17, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D3 * offset, dashLength * 8, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D3 * offset, dashLength * 14, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D3 * offset, dashLength * 17, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B2 * offset, dashLength * 8, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B2 * offset, dashLength * 14, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+
+    return result;
+}
+
+Sequence *sequencePhrase7(float offset) {
+    TimeSignature t;
+    Sequence *result = new Sequence(t);
+
+    result->add(Note(C5 * offset, dashLength * 0, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(C5 * offset, dashLength * 3, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(C5 * offset, dashLength * 6, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(C5 * offset, dashLength * 8, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(C5 * offset, dashLength * 18, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(C5 * offset, dashLength * 21, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(C5 * offset, dashLength * 24, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A4 * offset, dashLength * 9, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A4 * offset, dashLength * 15, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A4 * offset, dashLength * 17, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(C4 * offset, dashLength * 9, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A3 * offset, dashLength * 0, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A3 * offset, dashLength * 6, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A3 * offset, dashLength * 9, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A3 * offset, dashLength * 18, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A3 * offset, dashLength * 24, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(C3 * offset, dashLength * 0, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(C3 * offset, dashLength * 6, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(C3 * offset, dashLength * 9, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(C3 * offset, dashLength * 18, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(C3 * offset, dashLength * 24, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A2 * offset, dashLength * 0, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A2 * offset, dashLength * 6, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A2 * offset, dashLength * 18, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A2 * offset, dashLength * 24, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+
+    return result;
+}
+
+Sequence *sequencePhrase8(float offset) {
+    TimeSignature t;
+    Sequence *result = new Sequence(t);
+
+    result->add(Note(C5 * offset, dashLength * 0, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F5s * offset, dashLength * 10, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(E5 * offset, dashLength * 16, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D5 * offset, dashLength * 22, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B5 * offset, dashLength * 10, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A5 * offset, dashLength * 16, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(G5 * offset, dashLength * 22, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A4s * offset, dashLength * 1, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B4 * offset, dashLength * 10, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A4 * offset, dashLength * 16, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(G4 * offset, dashLength * 22, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(C4s * offset, dashLength * 1, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A3s * offset, dashLength * 1, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(C3s * offset, dashLength * 10, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B3 * offset, dashLength * 13, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A3 * offset, dashLength * 19, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(G3 * offset, dashLength * 26, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B2 * offset, dashLength * 10, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B2 * offset, dashLength * 16, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B2 * offset, dashLength * 22, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+
+    return result;
+}
+  
+Sequence *sequencePhrase9(float offset) {
+    TimeSignature t;
+    Sequence *result = new Sequence(t);
+
+    result->add(Note(E5 * offset, dashLength * 2, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(C5s * offset, dashLength * 5, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(E5 * offset, dashLength * 17, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F5s * offset, dashLength * 5, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B4 * offset, dashLength * 2, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B4 * offset, dashLength * 17, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(E4 * offset, dashLength * 2, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F4s * offset, dashLength * 5, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(E4 * offset, dashLength * 17, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B3 * offset, dashLength * 5, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A3s * offset, dashLength * 11, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A3s * offset, dashLength * 17, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A3s * offset, dashLength * 23, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B2 * offset, dashLength * 2, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A2s * offset, dashLength * 8, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A2s * offset, dashLength * 14, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A2s * offset, dashLength * 20, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+
+    return result;
+}
+
+Sequence *sequencePhrase10(float offset) {
+    TimeSignature t;
+    Sequence *result = new Sequence(t);
+
+    result->add(Note(F5s * offset, dashLength * 3, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F5s * offset, dashLength * 6, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(E5 * offset, dashLength * 12, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D5 * offset, dashLength * 18, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(E5 * offset, dashLength * 24, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B5 * offset, dashLength * 3, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B5 * offset, dashLength * 6, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A5 * offset, dashLength * 12, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(G5 * offset, dashLength * 18, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B4 * offset, dashLength * 24, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B4 * offset, dashLength * 3, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B4 * offset, dashLength * 6, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A4 * offset, dashLength * 12, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(G4 * offset, dashLength * 18, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(E4 * offset, dashLength * 24, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B3 * offset, dashLength * 6, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B3 * offset, dashLength * 9, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B3 * offset, dashLength * 12, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B3 * offset, dashLength * 15, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B3 * offset, dashLength * 18, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B3 * offset, dashLength * 21, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B3 * offset, dashLength * 24, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A3s * offset, dashLength * 3, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F3s * offset, dashLength * 6, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F3s * offset, dashLength * 9, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F3s * offset, dashLength * 12, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F3s * offset, dashLength * 15, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F3s * offset, dashLength * 18, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F3s * offset, dashLength * 21, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F3s * offset, dashLength * 24, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A2 * offset, dashLength * 0, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B2 * offset, dashLength * 6, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B2 * offset, dashLength * 9, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B2 * offset, dashLength * 12, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B2 * offset, dashLength * 15, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B2 * offset, dashLength * 18, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B2 * offset, dashLength * 21, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B2 * offset, dashLength * 24, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+
+    return result;
+}
+
+Sequence *sequencePhrase11(float offset) {
+    TimeSignature t;
+    Sequence *result = new Sequence(t);
+
+    result->add(Note(F5s * offset, dashLength * 13, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A5s * offset, dashLength * 13, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(C5s * offset, dashLength * 1, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(C5s * offset, dashLength * 13, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F5s * offset, dashLength * 1, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(E5 * offset, dashLength * 13, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F4s * offset, dashLength * 1, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B3 * offset, dashLength * 1, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A3s * offset, dashLength * 4, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A3s * offset, dashLength * 7, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A3s * offset, dashLength * 10, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A3s * offset, dashLength * 13, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F3s * offset, dashLength * 1, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F3 * offset, dashLength * 4, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F3 * offset, dashLength * 7, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F3 * offset, dashLength * 10, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F3 * offset, dashLength * 13, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B2 * offset, dashLength * 1, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A2s * offset, dashLength * 4, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A2s * offset, dashLength * 7, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A2s * offset, dashLength * 10, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A2s * offset, dashLength * 13, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+
+    return result;
+}
+
+Sequence *sequencePhrase12(float offset) {
+    TimeSignature t;
+    Sequence *result = new Sequence(t);
+
+    result->add(Note(E5 * offset, dashLength * 8, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F5s * offset, dashLength * 13, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(E5 * offset, dashLength * 14, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D5 * offset, dashLength * 16, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(E4 * offset, dashLength * 8, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F4s * offset, dashLength * 13, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(E4 * offset, dashLength * 14, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D4 * offset, dashLength * 16, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B4 * offset, dashLength * 17, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B3 * offset, dashLength * 17, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F3s * offset, dashLength * 2, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F3s * offset, dashLength * 5, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F3s * offset, dashLength * 11, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B3 * offset, dashLength * 17, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B3 * offset, dashLength * 23, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(C3s * offset, dashLength * 2, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(C3s * offset, dashLength * 5, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(C3s * offset, dashLength * 11, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F3 * offset, dashLength * 17, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F3 * offset, dashLength * 23, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F2s * offset, dashLength * 2, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F2s * offset, dashLength * 5, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F2s * offset, dashLength * 11, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B2 * offset, dashLength * 17, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B2 * offset, dashLength * 23, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+
+    return result;
+}
+
+Sequence *sequencePhrase13(float offset) {
+    TimeSignature t;
+    Sequence *result = new Sequence(t);
+
+    result->add(Note(E5 * offset, dashLength * 0, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D5 * offset, dashLength * 2, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(E5 * offset, dashLength * 3, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D5 * offset, dashLength * 5, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(E5 * offset, dashLength * 6, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D5 * offset, dashLength * 8, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(E5 * offset, dashLength * 9, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D5 * offset, dashLength * 11, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(E5 * offset, dashLength * 12, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D5 * offset, dashLength * 14, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B5 * offset, dashLength * 15, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(E4 * offset, dashLength * 0, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D4 * offset, dashLength * 2, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(E4 * offset, dashLength * 3, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D4 * offset, dashLength * 5, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(E4 * offset, dashLength * 6, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D4 * offset, dashLength * 8, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(E4 * offset, dashLength * 9, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D4 * offset, dashLength * 11, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(E4 * offset, dashLength * 12, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D4 * offset, dashLength * 14, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B4 * offset, dashLength * 15, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B3 * offset, dashLength * 9, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B3 * offset, dashLength * 15, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B3 * offset, dashLength * 21, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F3s * offset, dashLength * 24, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F3s * offset, dashLength * 0, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F3s * offset, dashLength * 3, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F3s * offset, dashLength * 9, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F3s * offset, dashLength * 15, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F3s * offset, dashLength * 21, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(C3s * offset, dashLength * 24, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B2 * offset, dashLength * 0, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B2 * offset, dashLength * 3, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F2s * offset, dashLength * 0, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F2s * offset, dashLength * 3, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B2 * offset, dashLength * 9, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B2 * offset, dashLength * 15, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B2 * offset, dashLength * 21, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F2s * offset, dashLength * 24, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+
+    return result;
+}
+
+Sequence *sequencePhrase14(float offset) {
+    TimeSignature t;
+    Sequence *result = new Sequence(t);
+
+    result->add(Note(E5 * offset, dashLength * 4, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F5s * offset, dashLength * 9, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(E5 * offset, dashLength * 10, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D5 * offset, dashLength * 12, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(E5 * offset, dashLength * 22, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D5 * offset, dashLength * 24, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(E5 * offset, dashLength * 25, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(E4 * offset, dashLength * 4, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F4s * offset, dashLength * 9, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(E4 * offset, dashLength * 10, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D4 * offset, dashLength * 12, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B4 * offset, dashLength * 12, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(E4 * offset, dashLength * 22, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D4 * offset, dashLength * 24, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(E4 * offset, dashLength * 25, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B3 * offset, dashLength * 12, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F3s * offset, dashLength * 1, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F3s * offset, dashLength * 7, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B3 * offset, dashLength * 13, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B3 * offset, dashLength * 19, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(C3s * offset, dashLength * 1, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(C3s * offset, dashLength * 7, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F3s * offset, dashLength * 13, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F3s * offset, dashLength * 19, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F3s * offset, dashLength * 22, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F3s * offset, dashLength * 25, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B2 * offset, dashLength * 22, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B2 * offset, dashLength * 25, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F2s * offset, dashLength * 1, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F2s * offset, dashLength * 7, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B2s * offset, dashLength * 13, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B2s * offset, dashLength * 19, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F2s * offset, dashLength * 22, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F2s * offset, dashLength * 25, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+
+    return result;
+}
+
+Sequence *sequencePhrase15(float offset) {
+    TimeSignature t;
+    Sequence *result = new Sequence(t);
+
+    result->add(Note(D6 * offset, dashLength * 20, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D5 * offset, dashLength * 1, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(E5 * offset, dashLength * 2, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D5 * offset, dashLength * 4, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B5 * offset, dashLength * 5, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D5 * offset, dashLength * 17, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D5 * offset, dashLength * 20, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B5 * offset, dashLength * 23, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D4 * offset, dashLength * 1, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(E4 * offset, dashLength * 2, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D4 * offset, dashLength * 4, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B4 * offset, dashLength * 5, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B4 * offset, dashLength * 13, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B4 * offset, dashLength * 14, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B4 * offset, dashLength * 16, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D4 * offset, dashLength * 17, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B4 * offset, dashLength * 23, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B3 * offset, dashLength * 13, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B3 * offset, dashLength * 14, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B3 * offset, dashLength * 16, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B3 * offset, dashLength * 5, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B3 * offset, dashLength * 11, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B3 * offset, dashLength * 17, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B3 * offset, dashLength * 20, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F3s * offset, dashLength * 5, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F3s * offset, dashLength * 11, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(F3s * offset, dashLength * 17, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D3 * offset, dashLength * 20, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B2 * offset, dashLength * 5, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B2 * offset, dashLength * 11, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B2 * offset, dashLength * 17, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B2 * offset, dashLength * 20, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+
+    return result;
+}
+
+Sequence *sequencePhrase16(float offset) {
+    TimeSignature t;
+    Sequence *result = new Sequence(t);
+
+    result->add(Note(D6 * offset, dashLength * 0, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D6 * offset, dashLength * 6, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D6 * offset, dashLength * 11, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D6 * offset, dashLength * 12, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D6 * offset, dashLength * 14, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D6 * offset, dashLength * 15, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D6 * offset, dashLength * 17, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(C6s * offset, dashLength * 18, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(C6s * offset, dashLength * 24, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D5 * offset, dashLength * 0, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D5 * offset, dashLength * 6, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D5 * offset, dashLength * 11, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D5 * offset, dashLength * 12, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D5 * offset, dashLength * 14, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D5 * offset, dashLength * 15, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D5 * offset, dashLength * 17, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(C5s * offset, dashLength * 18, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A5s * offset, dashLength * 21, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(C5s * offset, dashLength * 24, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A4s * offset, dashLength * 21, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(C4s * offset, dashLength * 18, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B3 * offset, dashLength * 0, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B3 * offset, dashLength * 11, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B3 * offset, dashLength * 12, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B3 * offset, dashLength * 14, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B3 * offset, dashLength * 15, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B3 * offset, dashLength * 17, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A3s * offset, dashLength * 18, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D3 * offset, dashLength * 0, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D3 * offset, dashLength * 11, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D3 * offset, dashLength * 12, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D3 * offset, dashLength * 14, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D3 * offset, dashLength * 15, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D3 * offset, dashLength * 17, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(C3s * offset, dashLength * 18, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B2 * offset, dashLength * 0, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B2 * offset, dashLength * 11, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B2 * offset, dashLength * 12, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B2 * offset, dashLength * 14, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B2 * offset, dashLength * 15, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B2 * offset, dashLength * 17, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+
+    return result;
+}
+
+Sequence *sequencePhrase17(float offset) {
+    TimeSignature t;
+    Sequence *result = new Sequence(t);
+
+    result->add(Note(D6 * offset, dashLength * 16, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D6 * offset, dashLength * 22, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D5 * offset, dashLength * 13, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D5 * offset, dashLength * 16, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B5 * offset, dashLength * 19, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D5 * offset, dashLength * 22, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B4 * offset, dashLength * 9, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B4 * offset, dashLength * 10, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B4 * offset, dashLength * 12, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D4 * offset, dashLength * 13, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B4 * offset, dashLength * 19, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B3 * offset, dashLength * 9, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B3 * offset, dashLength * 10, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B3 * offset, dashLength * 12, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+
+    result->add(Note(B3 * offset, dashLength * 16, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B3 * offset, dashLength * 22, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+
+    result->add(Note(D3 * offset, dashLength * 16, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D3 * offset, dashLength * 22, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+
+    result->add(Note(B2 * offset, dashLength * 16, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B2 * offset, dashLength * 22, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+
+    return result;
+}
+
+Sequence *sequencePhrase18(float offset) {
+    TimeSignature t;
+    Sequence *result = new Sequence(t);
+
+    result->add(Note(D6 * offset, dashLength * 2, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D6 * offset, dashLength * 7, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D6 * offset, dashLength * 8, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D6 * offset, dashLength * 10, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D6 * offset, dashLength * 11, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D6 * offset, dashLength * 13, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(C6s * offset, dashLength * 14, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D5 * offset, dashLength * 2, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D5 * offset, dashLength * 7, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D5 * offset, dashLength * 8, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D5 * offset, dashLength * 10, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D5 * offset, dashLength * 11, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D5 * offset, dashLength * 13, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(C5s * offset, dashLength * 14, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(C4s * offset, dashLength * 14, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B3 * offset, dashLength * 7, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B3 * offset, dashLength * 8, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B3 * offset, dashLength * 10, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B3 * offset, dashLength * 11, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B3 * offset, dashLength * 13, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(A3s * offset, dashLength * 14, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D3 * offset, dashLength * 7, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D3 * offset, dashLength * 8, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D3 * offset, dashLength * 10, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D3 * offset, dashLength * 11, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(D3 * offset, dashLength * 13, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(C3s * offset, dashLength * 14, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B2 * offset, dashLength * 7, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B2 * offset, dashLength * 8, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B2 * offset, dashLength * 10, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B2 * offset, dashLength * 11, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+    result->add(Note(B2 * offset, dashLength * 13, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
+
+    return result;
+}
@@ -0,0 +1,49 @@
+#ifndef SCORE_HPP
+#define SCORE_HPP
+
+#include "Sequence.hpp"
+
+const float dashLength = 1.f / 6.f;
+const float BPM = 77.f;
+const float wholeNote = 240.f / BPM * 1000.f;
+const float halfNote = wholeNote / 2.f;
+const float quarterNote = wholeNote / 4.f;
+const float eighthNote = quarterNote / 2.f;
+const float sixteenthNote = eighthNote / 2.f;
+const float dottedHalfNote = halfNote * 1.5f;
+const float dottedQuarterNote = quarterNote * 1.5f;
+const float dottedEighthNote = dottedQuarterNote / 2.f;
+const float dottedSixteenthNote = dottedEighthNote / 2.f;
+const float amplitude = 0.25f;
+
+// Phrases are placed every 27 dashes and mixed at half amplitude
+const int kNumPhrases = 18;
+const float phraseAmp = 0.5f;
+
+// The whole piece, with every frequency multiplied by offset
+Sequence *sequence(float offset = 1.0);
+
+// Phrase n (1 to kNumPhrases) on its own, and where it starts in the piece
+Sequence *sequencePhrase(int n, float offset = 1.0);
+float phraseStartBeat(int n);
+
+Sequence *sequencePhrase1(float offset = 1.0);
+Sequence *sequencePhrase2(float offset = 1.0);
+Sequence *sequencePhrase3(float offset = 1.0);
+Sequence *sequencePhrase4(float offset = 1.0);
+Sequence *sequencePhrase5(float offset = 1.0);
+Sequence *sequencePhrase6(float offset = 1.0);
+Sequence *sequencePhrase7(float offset = 1.0);
+Sequence *sequencePhrase8(float offset = 1.0);
+Sequence *sequencePhrase9(float offset = 1.0);
+Sequence *sequencePhrase10(float offset = 1.0);
+Sequence *sequencePhrase11(float offset = 1.0);
+Sequence *sequencePhrase12(float offset = 1.0);
+Sequence *sequencePhrase13(float offset = 1.0);
+Sequence *sequencePhrase14(float offset = 1.0);
+Sequence *sequencePhrase15(float offset = 1.0);
+Sequence *sequencePhrase16(float offset = 1.0);
+Sequence *sequencePhrase17(float offset = 1.0);
+Sequence *sequencePhrase18(float offset = 1.0);
+
+#endif
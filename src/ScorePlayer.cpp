@@ -0,0 +1,219 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+
+#include "RtLog.hpp"
+#include "Score.hpp"
+#include "ScorePlayer.hpp"
+
+namespace {
+    int64_t nowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+}
+
+std::unique_ptr<CompiledScore> CompiledScore::compile(const Sequence &s, const TempoMap &tempo)
+{
+    std::unique_ptr<CompiledScore> score(new CompiledScore);
+    score->sampleRate = tempo.sampleRate();
+    for (const Note &note : *s.getNotes()) {
+        const int64_t start = TempoMap::ticks(note.getTime());
+        Event e;
+        e.frame = tempo.frame(start);
+        e.durationFrames = (int32_t)std::max<int64_t>(
+            1, tempo.frame(start + TempoMap::ticks(note.getDuration())) - e.frame);
+        e.freq = note.getFreq();
+        e.amp = note.getAmp();
+        score->events.push_back(e);
+    }
+    score->finish();
+    return score;
+}
+
+std::unique_ptr<CompiledScore> CompiledScore::compile(const PackedScore &s, const TempoMap &tempo)
+{
+    static_assert(PackedScore::kTicksPerBeat == TempoMap::kTicksPerBeat,
+                  "packed ticks go to the tempo map as they are");
+    std::unique_ptr<CompiledScore> score(new CompiledScore);
+    score->sampleRate = tempo.sampleRate();
+    score->events.reserve(s.size());
+    for (const PackedNote &note : s.notes()) {
+        Event e;
+        e.frame = tempo.frame(note.tick);
+        e.durationFrames = (int32_t)std::max<int64_t>(1, tempo.frame(note.tick + note.duration) - e.frame);
+        e.freq = s.freq(note);
+        e.amp = PackedScore::amp(note);
+        score->events.push_back(e);
+    }
+    score->finish();
+    return score;
+}
+
+std::unique_ptr<CompiledScore> CompiledScore::compile(const Sequence &s, float bpm, double sampleRate)
+{
+    return compile(s, TempoMap(sampleRate, bpm));
+}
+
+std::unique_ptr<CompiledScore> CompiledScore::compile(const PackedScore &s, float bpm, double sampleRate)
+{
+    return compile(s, TempoMap(sampleRate, bpm));
+}
+
+void CompiledScore::finish()
+{
+    std::stable_sort(events.begin(), events.end(),
+                     [](const Event &a, const Event &b) { return a.frame < b.frame; });
+
+    // Sweep starts and ends to find how many voices the score needs
+    std::vector<std::pair<int64_t, int>> edges;
+    edges.reserve(2 * events.size());
+    for (const Event &e : events) {
+        edges.emplace_back(e.frame, 1);
+        edges.emplace_back(e.frame + e.durationFrames, -1);
+    }
+    std::sort(edges.begin(), edges.end());
+    int held = 0;
+    maxPolyphony = 0;
+    for (auto &edge : edges) {
+        held += edge.second;
+        maxPolyphony = std::max(maxPolyphony, held);
+    }
+    lengthFrames = edges.empty() ? 0 : edges.back().first;
+}
+
+ScorePlayer::ScorePlayer() {}
+
+ScorePlayer::~ScorePlayer()
+{
+    if (mCompiler.joinable()) {
+        mCompiler.join();
+    }
+}
+
+void ScorePlayer::compileAsync(float offset, float bpm, double sampleRate)
+{
+    if (mCompiler.joinable()) {
+        mCompiler.join();
+    }
+    mScore = nullptr;
+    mCompileDone = false;
+    mCompiler = std::thread([this, offset, bpm, sampleRate] {
+        Sequence *s = sequence(offset);
+        mCompiled = CompiledScore::compile(*s, bpm, sampleRate);
+        delete s;
+        mCompileDone.store(true, std::memory_order_release);
+    });
+}
+
+int ScorePlayer::voicesNeeded()
+{
+    mCompiler.join();
+    // Twice the score's polyphony: release tails, loop wraps and
+    // retriggers without crossfade overlap the notes that follow
+    return 2 * std::max(1, mCompiled->maxPolyphony);
+}
+
+void ScorePlayer::publish(int voices)
+{
+    mActive.capacity(voices);
+    mScore.store(mCompiled.get(), std::memory_order_release);
+}
+
+void ScorePlayer::retrigger()
+{
+    mRequestTime = nowNs();
+    mRequest = 1;
+}
+
+void ScorePlayer::stop() { mRequest = 2; }
+
+bool ScorePlayer::lastLatency(double &ms)
+{
+    if (!mLatencyReady.exchange(false)) {
+        return false;
+    }
+    ms = mLatencyMs;
+    return true;
+}
+
+void ScorePlayer::process(AudioIOData &io, PolySynth &synth, VoiceTaker getVoice)
+{
+    const CompiledScore *score = mScore.load(std::memory_order_acquire);
+    if (!score) {
+        return; // a retrigger stays pending until compilation finishes
+    }
+
+    const int request = mRequest.exchange(0);
+    if (request != 0) {
+        if (crossfade || request == 2) {
+            mActive.releaseAll(synth);
+        } else {
+            // Let old notes run to their own ends on the new timeline
+            mActive.rebase(mPlayhead);
+        }
+        mPlaying = request == 1;
+        mMeasuring = mPlaying;
+        mPlayhead = 0;
+        mPassStart = 0;
+        mNext = 0;
+    }
+
+    const int frames = io.framesPerBuffer();
+    const int64_t end = mPlayhead + frames;
+
+    // Note-offs due in this block
+    mActive.releaseBefore(synth, end);
+    if (!mPlaying) {
+        return;
+    }
+
+    const auto &events = score->events;
+    for (;;) {
+        for (; mNext < events.size() && mPassStart + events[mNext].frame < end; mNext++) {
+            const CompiledScore::Event &e = events[mNext];
+            SynthVoice *voice = getVoice(synth);
+            if (!voice) {
+                continue;
+            }
+            if (!mParams.resolved(getVoice)) {
+                // Played as another voice type than compileAsync prepared
+                mParams.resolve(getVoice, *voice);
+            }
+            mParams.set(TriggerParams::kAmplitude, e.amp);
+            mParams.set(TriggerParams::kFrequency, e.freq);
+            mParams.set(TriggerParams::kAttack, 0.01f);
+            mParams.set(TriggerParams::kRelease, 0.05f);
+            mParams.set(TriggerParams::kPan, 0.f);
+            mParams.apply(*voice);
+
+            const int64_t frame = mPassStart + e.frame;
+            const int offset = (int)std::max<int64_t>(0, frame - mPlayhead);
+            const int id = mNextId;
+            // Wrap below NoteScheduler's ids; ids from weeks ago are long released
+            mNextId = mNextId == (1 << 30) - 1 ? 1 << 20 : mNextId + 1;
+            synth.triggerOn(voice, offset, id);
+            rtlog::debug(rtlog::kScore, "note {} Hz, amp {}, frame {}", e.freq, e.amp, frame);
+            mActive.add(synth, id, frame + e.durationFrames);
+
+            if (mMeasuring) {
+                mMeasuring = false;
+                mLatencyMs = (nowNs() - mRequestTime.load()) / 1e6 + 1000.0 * offset / score->sampleRate;
+                mLatencyReady = true;
+            }
+        }
+        // The next pass starts in this block: go round again
+        if (loop && mNext >= events.size() && score->lengthFrames > 0 &&
+            mPassStart + score->lengthFrames < end) {
+            mPassStart += score->lengthFrames;
+            mNext = 0;
+            continue;
+        }
+        break;
+    }
+    mPlayhead = end;
+    if (!loop && mNext >= events.size() && mActive.size() == 0) {
+        mPlaying = false;
+    }
+}
@@ -0,0 +1,130 @@
+#ifndef SCOREPLAYER_HPP
+#define SCOREPLAYER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "al/scene/al_PolySynth.hpp"
+
+#include "PackedScore.hpp"
+#include "ScoreVoices.hpp"
+#include "Sequence.hpp"
+#include "TempoMap.hpp"
+
+using namespace al;
+
+// The score flattened into start frames, ready to be played from the
+// audio thread. Built once and never modified afterwards. Frames come
+// from a TempoMap, so every event sits exactly where its beat falls on
+// the 64-bit sample clock.
+struct CompiledScore {
+    struct Event {
+        int64_t frame;          // start, in frames from the top
+        int32_t durationFrames;
+        float freq;
+        float amp;
+    };
+
+    std::vector<Event> events; // sorted by frame
+    double sampleRate = 0;
+    int maxPolyphony = 0;      // most notes held at once
+    int64_t lengthFrames = 0;  // end of the last note; one loop pass
+
+    static std::unique_ptr<CompiledScore> compile(const Sequence &s, const TempoMap &tempo);
+    static std::unique_ptr<CompiledScore> compile(const PackedScore &s, const TempoMap &tempo);
+    // At a constant tempo
+    static std::unique_ptr<CompiledScore> compile(const Sequence &s, float bpm, double sampleRate);
+    static std::unique_ptr<CompiledScore> compile(const PackedScore &s, float bpm, double sampleRate);
+    // Sort the events and count the polyphony, after filling events
+    void finish();
+};
+
+// Plays a CompiledScore from the audio callback. The score is compiled
+// on a background thread at startup; after that, (re)starting it from a
+// key press only moves the playhead, which the audio thread picks up at
+// the next block. Notes still sounding from the previous pass are
+// released at once when crossfade is on, so they fade over their
+// release time instead of overlapping the restart. With loop on, the
+// score starts over every lengthFrames; pass n is placed at exactly
+// n * lengthFrames, so the loop never drifts however long it runs.
+//
+// Only the CompiledScore is built on the background thread. Voices for
+// the score are added to the synth by prepare(), on the main thread like
+// every other Gamma object, and their trigger parameters resolved by
+// index, so the audio thread neither allocates voices nor looks
+// parameters up by name.
+class ScorePlayer {
+    public:
+        bool crossfade = true;
+        bool loop = false;
+
+        ScorePlayer();
+        ~ScorePlayer();
+
+        // Start compiling sequence(offset) at bpm in the background
+        void compileAsync(float offset, float bpm, double sampleRate);
+
+        // Main thread, e.g. once per frame. Once compilation has finished,
+        // add enough VoiceType voices to synth to play the score, resolve
+        // their trigger parameters and hand the score to the audio
+        // thread. Returns ready().
+        template <class VoiceType>
+        bool prepare(PolySynth &synth) {
+            if (ready() || !mCompileDone.load(std::memory_order_acquire)) {
+                return ready();
+            }
+            const int voices = voicesNeeded();
+            synth.allocatePolyphony<VoiceType>(voices);
+            VoiceType probe;
+            probe.init();
+            mParams.resolve(&takeVoice<VoiceType>, probe);
+            publish(voices);
+            return true;
+        }
+        bool ready() const { return mScore.load() != nullptr; }
+
+        // Restart from the top, or stop. Safe from any thread.
+        void retrigger();
+        void stop();
+
+        // Audio thread: trigger and release the notes falling in this block.
+        template <class VoiceType>
+        void process(AudioIOData &io, PolySynth &synth) {
+            process(io, synth, &takeVoice<VoiceType>);
+        }
+        void process(AudioIOData &io, PolySynth &synth, VoiceTaker getVoice);
+
+        // Returns true once per retrigger, with the time from retrigger()
+        // to the first sample of the first note, in milliseconds.
+        bool lastLatency(double &ms);
+
+    private:
+        int voicesNeeded();
+        void publish(int voices);
+
+        std::thread mCompiler;
+        std::unique_ptr<CompiledScore> mCompiled;
+        std::atomic<bool> mCompileDone{false};
+        std::atomic<const CompiledScore *> mScore{nullptr};
+
+        // Requests from other threads: 1 retrigger, 2 stop
+        std::atomic<int> mRequest{0};
+        std::atomic<int64_t> mRequestTime{0}; // steady_clock ns
+        std::atomic<bool> mLatencyReady{false};
+        double mLatencyMs = 0;
+
+        // Audio thread state
+        bool mPlaying = false;
+        bool mMeasuring = false;
+        int64_t mPlayhead = 0;
+        int64_t mPassStart = 0; // frame the current loop pass began at
+        size_t mNext = 0;
+        int mNextId = 1 << 20; // clear of the ids keyboard notes use
+        TriggerParams mParams;  // resolved before the score is published
+        ActiveNotes mActive;    // sized from the score's polyphony
+};
+
+#endif
@@ -0,0 +1,145 @@
+#ifndef SCOREVOICES_HPP
+#define SCOREVOICES_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "al/scene/al_PolySynth.hpp"
+#include "al/ui/al_Parameter.hpp"
+
+using namespace al;
+
+// Voice bookkeeping for code that triggers notes from the audio thread
+// (ScorePlayer, NoteScheduler): trigger parameters written by index, and
+// the notes waiting for their note-off.
+
+// Takes a free voice of VoiceType. Its address also names the voice type
+// that a TriggerParams was resolved for.
+template <class VoiceType>
+SynthVoice *takeVoice(PolySynth &synth) {
+    return synth.getVoice<VoiceType>();
+}
+
+typedef SynthVoice *(*VoiceTaker)(PolySynth &);
+
+// The trigger parameters a score note sets. resolve() looks their names up
+// once per voice type; after that a note is a few stores and a single
+// setTriggerParams() call, with no string compares.
+class TriggerParams {
+    public:
+        enum Param { kAmplitude, kFrequency, kAttack, kRelease, kPan, kNumParams };
+
+        TriggerParams() {
+            std::fill(mIndex, mIndex + kNumParams, -1);
+            mValues.reserve(32); // so a late resolve() on the audio thread doesn't allocate
+        }
+
+        bool resolved(VoiceTaker type) const { return mType == type; }
+
+        // Indices and defaults of voice, an instance of type
+        void resolve(VoiceTaker type, SynthVoice &voice) {
+            static const char *const kNames[kNumParams] = {"amplitude", "frequency", "attackTime",
+                                                           "releaseTime", "pan"};
+            std::fill(mIndex, mIndex + kNumParams, -1);
+            mValues.clear();
+            for (ParameterMeta *meta : voice.triggerParameters()) {
+                const std::string name = meta->getName();
+                for (int p = 0; p < kNumParams; p++) {
+                    if (name == kNames[p]) {
+                        mIndex[p] = (int)mValues.size();
+                    }
+                }
+                Parameter *param = dynamic_cast<Parameter *>(meta);
+                mValues.push_back(param ? param->get() : 0.f);
+            }
+            mType = type;
+        }
+
+        void set(Param p, float value) {
+            if (mIndex[p] >= 0) {
+                mValues[mIndex[p]] = value;
+            }
+        }
+
+        void apply(SynthVoice &voice) { voice.setTriggerParams(mValues.data(), (int)mValues.size()); }
+
+        // voice's own parameter p, or null if its type has none
+        Parameter *parameter(SynthVoice &voice, Param p) const {
+            return mIndex[p] < 0 ? nullptr : dynamic_cast<Parameter *>(voice.triggerParameters()[mIndex[p]]);
+        }
+
+    private:
+        VoiceTaker mType = nullptr;
+        int mIndex[kNumParams];
+        std::vector<float> mValues; // every trigger parameter, in voice order
+};
+
+// Sounding notes and the frames their note-offs fall on. Capacity is set
+// up front; when it is full, add() releases the note due to end soonest
+// rather than losing track of the new one, so no note is left hanging.
+class ActiveNotes {
+    public:
+        void capacity(int n) { mNotes.resize(n); mSize = std::min(mSize, n); }
+        int capacity() const { return (int)mNotes.size(); }
+        int size() const { return mSize; }
+        int stolen() const { return mStolen; }
+
+        void add(PolySynth &synth, int id, int64_t offFrame) {
+            if (mNotes.empty()) {
+                synth.triggerOff(id);
+                return;
+            }
+            if (mSize == (int)mNotes.size()) {
+                int soonest = 0;
+                for (int i = 1; i < mSize; i++) {
+                    if (mNotes[i].offFrame < mNotes[soonest].offFrame) {
+                        soonest = i;
+                    }
+                }
+                synth.triggerOff(mNotes[soonest].id);
+                mNotes[soonest] = mNotes[--mSize];
+                mStolen++;
+            }
+            mNotes[mSize++] = {id, offFrame};
+        }
+
+        // Note-offs due before frame end
+        void releaseBefore(PolySynth &synth, int64_t end) {
+            for (int i = 0; i < mSize;) {
+                if (mNotes[i].offFrame < end) {
+                    synth.triggerOff(mNotes[i].id);
+                    mNotes[i] = mNotes[--mSize];
+                } else {
+                    i++;
+                }
+            }
+        }
+
+        void releaseAll(PolySynth &synth) {
+            for (int i = 0; i < mSize; i++) {
+                synth.triggerOff(mNotes[i].id);
+            }
+            mSize = 0;
+        }
+
+        // Move every note-off frames earlier, onto a timeline restarted there
+        void rebase(int64_t frames) {
+            for (int i = 0; i < mSize; i++) {
+                mNotes[i].offFrame -= frames;
+            }
+        }
+
+    private:
+        struct Note {
+            int id;
+            int64_t offFrame;
+        };
+
+        std::vector<Note> mNotes;
+        int mSize = 0;
+        int mStolen = 0;
+};
+
+#endif
@@ -0,0 +1,105 @@
+#ifndef SEQUENCE_HPP
+#define SEQUENCE_HPP
+
+#include <vector>
+
+class TimeSignature {
+    private:
+        int upper;
+        int lower;
+
+    public:
+        TimeSignature() {
+            this->upper = 4;
+            this->lower = 4;
+        }
+};
+
+class Note {
+    private:
+        float freq;
+        float time;
+        float duration;
+        float amp;
+        float attack;
+        float release;
+        float decay;
+        float sustain;
+    
+    public:
+        Note() {
+            this->freq = 440.0;
+            this->time = 0;
+            this->duration = 0.5;
+            this->amp = 0.2;
+            this->attack = 0.05;
+            this->release = 0.05;
+            this->decay = 0.5;
+            this->sustain = 0.05;
+        }
+        Note(float freq, float time = 0.0f, float duration = 0.5f, float amp = 0.2f, float attack = 0.05f, float release = 0.05f, float decay = 0.5f, float sustain = 0.05f) {
+            this->freq = freq;
+            this->time = time;
+            this->duration = duration;
+            this->amp = amp;
+            this->attack = attack;
+            this->release = release;
+            this->decay = decay;
+            this->sustain = sustain;
+        }
+        // Return an identical note, but offset by the
+        // number of beats indicated by beatOffset,
+        // and with amplitude multiplied by ampMult
+        Note(const Note &n, float beatOffset, float ampMult = 1.0f) {
+            this->freq = n.freq;
+            this->time = n.time + beatOffset;
+            this->duration = n.duration;
+            this->amp = n.amp * ampMult;
+            this->attack = n.attack;
+            this->release = n.release;
+            this->decay = n.decay;
+            this->sustain = n.sustain;
+        }
+        Note(const Note &n) {
+            this->freq = n.freq;
+            this->time = n.time;
+            this->duration = n.duration;
+            this->amp = n.amp;
+            this->attack = n.attack;
+            this->release = n.release;
+            this->decay = n.decay;
+            this->sustain = n.sustain;
+        }
+        Note &operator=(const Note &) = default;
+        float getFreq() const { return this->freq; }
+        float getTime() const { return this->time; }
+        float getDuration() const { return this->duration; }
+        float getAmp() const { return this->amp; }
+        float getAttack() const { return this->attack; }
+        float getRelease() const { return this->release; }
+        float getDecay() const { return this->decay; }
+        float getSustain() const { return this->sustain; }
+};
+
+class Sequence {
+    private:
+        TimeSignature ts;
+        std::vector<Note> notes;
+
+    public:
+        Sequence(TimeSignature ts) { this->ts = ts; }
+
+        void add(Note n) { notes.push_back(n); }
+
+    /**Add notes from the source sequence s,
+        *but starting on the beat indicated by startBeat
+        */
+    void addSequence(Sequence *s, float startBeat, float ampMult = 1.0) {
+        for(auto &note : *(s->getNotes())) { add(Note(note, startBeat, ampMult)); }
+    }
+
+    std::vector<Note> *getNotes() { return &notes; }
+    const std::vector<Note> *getNotes() const { return &notes; }
+};
+
+#endif
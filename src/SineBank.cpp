@@ -0,0 +1,151 @@
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define SINEBANK_SSE 1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define SINEBANK_NEON 1
+#endif
+
+#include "SineBank.hpp"
+
+namespace {
+    // Samples summed per pass; render() splits longer blocks
+    const int kPass = 64;
+}
+
+bool SineBank::add(float freq, float amp, float decaySeconds, double sampleRate)
+{
+    if (mCount >= kMaxPartials || freq <= 0 || freq >= sampleRate / 2) {
+        return false;
+    }
+    const double w = 2 * M_PI * freq / sampleRate;
+    const int i = mCount++;
+    mCos[i] = 1;
+    mSin[i] = 0;
+    mRotCos[i] = (float)std::cos(w);
+    mRotSin[i] = (float)std::sin(w);
+    mAmp[i] = amp;
+    // exp(ln(0.001) / samples) per sample
+    mDecay[i] = decaySeconds > 0 ? (float)std::exp(-6.907755 / (decaySeconds * sampleRate)) : 1.f;
+
+    // Keep the rest of the last group silent
+    for (int j = mCount; j % kLanes != 0; j++) {
+        mCos[j] = 1;
+        mSin[j] = 0;
+        mRotCos[j] = 1;
+        mRotSin[j] = 0;
+        mAmp[j] = 0;
+        mDecay[j] = 1;
+    }
+    return true;
+}
+
+void SineBank::render(float *out, int frames)
+{
+#if defined(SINEBANK_SSE) || defined(SINEBANK_NEON)
+    const int groups = (mCount + kLanes - 1) / kLanes;
+    for (int start = 0; start < frames; start += kPass) {
+        const int n = std::min(kPass, frames - start);
+        // Per-sample sums, one lane per partial in the group
+#if defined(SINEBANK_SSE)
+        __m128 acc[kPass];
+        for (int i = 0; i < n; i++) {
+            acc[i] = _mm_setzero_ps();
+        }
+        for (int g = 0; g < groups; g++) {
+            const int k = g * kLanes;
+            __m128 c = _mm_load_ps(mCos + k), s = _mm_load_ps(mSin + k);
+            const __m128 rc = _mm_load_ps(mRotCos + k), rs = _mm_load_ps(mRotSin + k);
+            __m128 a = _mm_load_ps(mAmp + k);
+            const __m128 d = _mm_load_ps(mDecay + k);
+            for (int i = 0; i < n; i++) {
+                const __m128 c1 = _mm_sub_ps(_mm_mul_ps(c, rc), _mm_mul_ps(s, rs));
+                s = _mm_add_ps(_mm_mul_ps(s, rc), _mm_mul_ps(c, rs));
+                c = c1;
+                acc[i] = _mm_add_ps(acc[i], _mm_mul_ps(s, a));
+                a = _mm_mul_ps(a, d);
+            }
+            _mm_store_ps(mCos + k, c);
+            _mm_store_ps(mSin + k, s);
+            _mm_store_ps(mAmp + k, a);
+        }
+        for (int i = 0; i < n; i++) {
+            alignas(16) float lanes[kLanes];
+            _mm_store_ps(lanes, acc[i]);
+            out[start + i] += (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+        }
+#else
+        float32x4_t acc[kPass];
+        for (int i = 0; i < n; i++) {
+            acc[i] = vdupq_n_f32(0);
+        }
+        for (int g = 0; g < groups; g++) {
+            const int k = g * kLanes;
+            float32x4_t c = vld1q_f32(mCos + k), s = vld1q_f32(mSin + k);
+            const float32x4_t rc = vld1q_f32(mRotCos + k), rs = vld1q_f32(mRotSin + k);
+            float32x4_t a = vld1q_f32(mAmp + k);
+            const float32x4_t d = vld1q_f32(mDecay + k);
+            for (int i = 0; i < n; i++) {
+                const float32x4_t c1 = vmlsq_f32(vmulq_f32(c, rc), s, rs);
+                s = vmlaq_f32(vmulq_f32(s, rc), c, rs);
+                c = c1;
+                acc[i] = vmlaq_f32(acc[i], s, a);
+                a = vmulq_f32(a, d);
+            }
+            vst1q_f32(mCos + k, c);
+            vst1q_f32(mSin + k, s);
+            vst1q_f32(mAmp + k, a);
+        }
+        for (int i = 0; i < n; i++) {
+            const float32x2_t pair = vadd_f32(vget_low_f32(acc[i]), vget_high_f32(acc[i]));
+            out[start + i] += vget_lane_f32(vpadd_f32(pair, pair), 0);
+        }
+#endif
+    }
+    renormalize();
+#else
+    renderScalar(out, frames);
+#endif
+}
+
+void SineBank::renderScalar(float *out, int frames)
+{
+    for (int k = 0; k < mCount; k++) {
+        float c = mCos[k], s = mSin[k], a = mAmp[k];
+        for (int i = 0; i < frames; i++) {
+            const float c1 = c * mRotCos[k] - s * mRotSin[k];
+            s = s * mRotCos[k] + c * mRotSin[k];
+            c = c1;
+            out[i] += s * a;
+            a *= mDecay[k];
+        }
+        mCos[k] = c;
+        mSin[k] = s;
+        mAmp[k] = a;
+    }
+    renormalize();
+}
+
+bool SineBank::silent(float threshold) const
+{
+    for (int k = 0; k < mCount; k++) {
+        if (mAmp[k] >= threshold) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void SineBank::renormalize()
+{
+    // One Newton step towards 1 / |phasor|; the magnitude is always
+    // within float error of 1, so that is exact enough
+    for (int k = 0; k < mCount; k++) {
+        const float g = 1.5f - 0.5f * (mCos[k] * mCos[k] + mSin[k] * mSin[k]);
+        mCos[k] *= g;
+        mSin[k] *= g;
+    }
+}
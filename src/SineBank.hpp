@@ -0,0 +1,47 @@
+#ifndef SINEBANK_HPP
+#define SINEBANK_HPP
+
+// A bank of decaying sinusoids summed by one SIMD kernel. Each partial is
+// a unit phasor (c, s) advanced by a complex multiply per sample and
+// scaled by its own amplitude, which decays by a constant factor per
+// sample. That is six multiply-adds a partial-sample with no table reads
+// or sin() calls, and four partials share every instruction on SSE and
+// NEON. Phasors are renormalized after each render() so float error
+// never changes a partial's level, however long the note.
+class SineBank {
+    public:
+        static const int kMaxPartials = 64;
+
+        void clear() { mCount = 0; }
+        int size() const { return mCount; }
+
+        // Add a partial at freq Hz, starting at phase 0 with amplitude amp
+        // and falling 60 dB over decaySeconds (0 for no decay). Partials at
+        // or above Nyquist are refused, as are any past kMaxPartials.
+        bool add(float freq, float amp, float decaySeconds, double sampleRate);
+
+        // Add the sum of all partials to out, advancing them by frames
+        void render(float *out, int frames);
+        // Plain C++ version of render(), for testing the SIMD one
+        void renderScalar(float *out, int frames);
+
+        // Every partial has decayed below threshold
+        bool silent(float threshold) const;
+
+    private:
+        static const int kLanes = 4;
+
+        void renormalize();
+
+        int mCount = 0;
+        // Structure of arrays, padded to whole groups of kLanes with
+        // silent partials
+        alignas(16) float mCos[kMaxPartials];
+        alignas(16) float mSin[kMaxPartials];
+        alignas(16) float mRotCos[kMaxPartials];
+        alignas(16) float mRotSin[kMaxPartials];
+        alignas(16) float mAmp[kMaxPartials];
+        alignas(16) float mDecay[kMaxPartials];
+};
+
+#endif
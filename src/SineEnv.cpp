@@ -14,17 +14,22 @@
 
 #include <cassert>
 #include <vector>
+#include <algorithm>
 #include <cstdio>
 
 #include "SineEnv.hpp"
+#include "VoiceVisuals.hpp"
+#include "RtSafety.hpp"
+
 // Initialize voice. This function will only be called once per voice when
 // it is created. Voices will be reused if they are idle.
 void SineEnv::init() 
 {
-    // Intialize envelope
-    mAmpEnv.curve(0); // make segments lines
+    // Intialize envelope (LinearEnv segments are always straight lines)
     mAmpEnv.levels(0, 1, 1, 0);
     mAmpEnv.sustainPoint(2); // Make point 2 sustain until a release is issued
+    // Sized here for the current layout, so onProcess never allocates
+    mSpatial.layout(SpeakerLayout::current());
 
     // We have the mesh be a sphere
     addDisc(mMesh, 1.0, 30);
@@ -46,6 +51,8 @@ void SineEnv::init()
 // The audio processing function
 void SineEnv::onProcess(AudioIOData &io) 
 {
+    RT_SAFETY_SCOPE("SineEnv::onProcess");
+
     // Get the values from the parameters and apply them to the corresponding
     // unit generators. You could place these lines in the onTrigger() function,
     // but placing them here allows for realtime prototyping on a running
@@ -53,22 +60,53 @@ void SineEnv::onProcess(AudioIOData &io)
     // Parameters will update values once per audio callback because they
     // are outside the sample processing loop.
     mOsc.freq(getInternalParameterValue("frequency"));
+    mAmpEnv.sampleRate(io.framesPerSecond());
     mAmpEnv.lengths()[0] = getInternalParameterValue("attackTime");
     mAmpEnv.lengths()[2] = getInternalParameterValue("releaseTime");
     mPan.pos(getInternalParameterValue("pan"));
-    while (io())
+    float amp = getInternalParameterValue("amplitude");
+    // The envelope is computed a chunk at a time, then applied per sample
+    float env[kEnvChunk];
+    const int end = io.framesPerBuffer();
+    const SpeakerLayout *layout = SpeakerLayout::current();
+    if (layout && io.channelsOut() > 2)
+    {
+        // Multichannel: render mono and let the spatializer spread it,
+        // with pan sweeping the full circle of speakers
+        mSpatial.layout(layout);
+        mSpatial.position(getInternalParameterValue("pan") * 180.f);
+        float mono[kEnvChunk];
+        for (int start = io.frame() + 1; start < end; start += kEnvChunk)
+        {
+            const int n = std::min(kEnvChunk, end - start);
+            mAmpEnv.process(env, n);
+            for (int i = 0; i < n; i++)
+            {
+                mono[i] = mOsc() * env[i] * amp;
+            }
+            mSpatial.mix(mono, n, io, start);
+        }
+        if (mAmpEnv.done())
+            free();
+        return;
+    }
+    for (int start = io.frame() + 1; start < end; start += kEnvChunk)
     {
-        float s1 = mOsc() * mAmpEnv() * getInternalParameterValue("amplitude");
-        float s2;
-        mEnvFollow(s1);
-        mPan(s1, s1, s2);
-        io.out(0) += s1;
-        io.out(1) += s2;
+        const int n = std::min(kEnvChunk, end - start);
+        mAmpEnv.process(env, n);
+        for (int i = 0; i < n; i++)
+        {
+            float s1 = mOsc() * env[i] * amp;
+            float s2;
+            mPan(s1, s1, s2);
+            io.out(0, start + i) += s1;
+            io.out(1, start + i) += s2;
+        }
     }
     // We need to let the synth know that this voice is done
     // by calling the free(). This takes the voice out of the
     // rendering chain
-    if (mAmpEnv.done() && (mEnvFollow.value() < 0.001f))
+    if (mAmpEnv.done())
         free();
 }
 
@@ -81,9 +119,10 @@ void SineEnv::onProcess(Graphics &g)
     float amplitude = getInternalParameterValue("amplitude");
     // Now draw
     g.pushMatrix();
-    g.translate(frequency / 200 - 3, amplitude, -8);
-    g.scale(1 - amplitude, amplitude, 1);
-    g.color(mEnvFollow.value(), frequency / 1000, mEnvFollow.value() * 10, 0.4);
+    const VoiceGlyph v = VoiceGlyph::make(frequency, amplitude, mAmpEnv.value() * amplitude);
+    g.translate(v.x, v.y, v.z);
+    g.scale(v.sx, v.sy, 1);
+    g.color(v.r, v.g, v.b, v.a);
     g.draw(mMesh);
     g.popMatrix();
 }
@@ -91,6 +130,11 @@ void SineEnv::onProcess(Graphics &g)
 // The triggering functions just need to tell the envelope to start or release
 // The audio processing function checks when the envelope is done to remove
 // the voice from the processing chain.
-void SineEnv::onTriggerOn()  { mAmpEnv.reset(); }
+void SineEnv::onTriggerOn()
+{
+    mAmpEnv.reset();
+    // Start from silence rather than ramping from the last note's position
+    mSpatial.reset();
+}
 
 void SineEnv::onTriggerOff()  { mAmpEnv.release(); }
@@ -18,6 +18,9 @@
 #include <vector>
 #include <cstdio>
 
+#include "LinearEnv.hpp"
+#include "Spatializer.hpp"
+
 using namespace al;
 
 class SineEnv : public SynthVoice {
@@ -25,13 +28,16 @@ class SineEnv : public SynthVoice {
         // Unit generators
         gam::Pan<> mPan;
         gam::Sine<> mOsc;
-        gam::Env<3> mAmpEnv;
-        // envelope follower to connect audio output to graphics
-        gam::EnvFollow<> mEnvFollow;
+        LinearEnv<3> mAmpEnv;
+        // Used instead of mPan when the device has more than two outputs
+        Spatializer mSpatial;
 
         // Additional members
         Mesh mMesh;
 
+        // Envelope samples computed per pass of the audio loop
+        static const int kEnvChunk = 64;
+
         // Initialize voice. This function will only be called once per voice when
         // it is created. Voices will be reused if they are idle.
         void init() override;
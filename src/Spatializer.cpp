@@ -0,0 +1,155 @@
+#include <atomic>
+#include <cmath>
+
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define SPATIALIZER_SSE 1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define SPATIALIZER_NEON 1
+#endif
+
+#include "Spatializer.hpp"
+
+namespace {
+    std::shared_ptr<const SpeakerLayout> currentLayout;
+    std::atomic<const SpeakerLayout *> currentLayoutPtr{nullptr};
+
+    const float kDegrees = M_PI / 180.0;
+    // Channels whose gain stays below this for a whole block are skipped
+    const float kSilent = 1e-4f;
+}
+
+SpeakerLayout SpeakerLayout::ring(int n)
+{
+    std::vector<float> azimuth(n), elevation(n, 0.f);
+    for (int i = 0; i < n; i++) {
+        azimuth[i] = 360.f * i / n;
+    }
+    return fromDegrees(azimuth, elevation);
+}
+
+SpeakerLayout SpeakerLayout::dome(int rings, int perRing)
+{
+    std::vector<float> azimuth, elevation;
+    for (int r = 0; r < rings; r++) {
+        for (int i = 0; i < perRing; i++) {
+            // Stagger alternate rings so speakers don't line up vertically
+            azimuth.push_back(360.f * (i + 0.5f * (r % 2)) / perRing);
+            elevation.push_back(90.f * r / rings);
+        }
+    }
+    azimuth.push_back(0.f);
+    elevation.push_back(90.f);
+    return fromDegrees(azimuth, elevation);
+}
+
+SpeakerLayout SpeakerLayout::fromDegrees(const std::vector<float> &azimuth,
+                                         const std::vector<float> &elevation)
+{
+    SpeakerLayout layout;
+    for (size_t i = 0; i < azimuth.size(); i++) {
+        const float az = azimuth[i] * kDegrees;
+        const float el = (i < elevation.size() ? elevation[i] : 0.f) * kDegrees;
+        layout.mSpeakers.push_back({std::sin(az) * std::cos(el), std::sin(el),
+                                    std::cos(az) * std::cos(el)});
+    }
+    return layout;
+}
+
+void SpeakerLayout::current(std::shared_ptr<const SpeakerLayout> layout)
+{
+    currentLayout = std::move(layout);
+    currentLayoutPtr = currentLayout.get();
+}
+
+const SpeakerLayout *SpeakerLayout::current() { return currentLayoutPtr.load(std::memory_order_acquire); }
+
+void Spatializer::layout(const SpeakerLayout *l)
+{
+    if (l == mLayout) {
+        return;
+    }
+    mLayout = l;
+    const int n = l ? l->size() : 0;
+    mGains.assign(n, 0.f);
+    mLastGains.assign(n, 0.f);
+}
+
+void Spatializer::position(float azimuth, float elevation, float distance)
+{
+    if (!mLayout) {
+        return;
+    }
+    const float az = azimuth * kDegrees;
+    const float el = elevation * kDegrees;
+    const float x = distance * std::sin(az) * std::cos(el);
+    const float y = distance * std::sin(el);
+    const float z = distance * std::cos(az) * std::cos(el);
+
+    // g_i = k / d_i^a with k normalizing total power to 1
+    const float a = rolloffDb / (20.f * std::log10(2.f));
+    float power = 0.f;
+    for (int i = 0; i < mLayout->size(); i++) {
+        const SpeakerLayout::Speaker &s = (*mLayout)[i];
+        const float d2 = (s.x - x) * (s.x - x) + (s.y - y) * (s.y - y) +
+                         (s.z - z) * (s.z - z) + blur * blur;
+        mGains[i] = std::pow(d2, -0.5f * a);
+        power += mGains[i] * mGains[i];
+    }
+    const float k = power > 0.f ? 1.f / std::sqrt(power) : 0.f;
+    for (float &g : mGains) {
+        g *= k;
+    }
+}
+
+void Spatializer::mix(const float *mono, int frames, AudioIOData &io, int start)
+{
+    if (!mLayout || frames <= 0) {
+        return;
+    }
+    const int channels = std::min(mLayout->size(), io.channelsOut());
+    for (int c = 0; c < channels; c++) {
+        const float g0 = mLastGains[c];
+        const float g1 = mGains[c];
+        mLastGains[c] = g1;
+        if (g0 < kSilent && g1 < kSilent) {
+            continue;
+        }
+        mixRamp(mono, io.outBuffer(c) + start, frames, g0, (g1 - g0) / frames);
+    }
+}
+
+void Spatializer::mixRamp(const float *in, float *out, int frames, float gain, float step)
+{
+    int i = 0;
+#if defined(SPATIALIZER_SSE)
+    __m128 g = _mm_setr_ps(gain, gain + step, gain + 2 * step, gain + 3 * step);
+    const __m128 gStep = _mm_set1_ps(4 * step);
+    for (; i + 4 <= frames; i += 4) {
+        const __m128 x = _mm_loadu_ps(in + i);
+        const __m128 o = _mm_loadu_ps(out + i);
+        _mm_storeu_ps(out + i, _mm_add_ps(o, _mm_mul_ps(x, g)));
+        g = _mm_add_ps(g, gStep);
+    }
+#elif defined(SPATIALIZER_NEON)
+    const float g4[4] = {gain, gain + step, gain + 2 * step, gain + 3 * step};
+    float32x4_t g = vld1q_f32(g4);
+    const float32x4_t gStep = vdupq_n_f32(4 * step);
+    for (; i + 4 <= frames; i += 4) {
+        vst1q_f32(out + i, vmlaq_f32(vld1q_f32(out + i), vld1q_f32(in + i), g));
+        g = vaddq_f32(g, gStep);
+    }
+#endif
+    for (; i < frames; i++) {
+        out[i] += in[i] * (gain + step * i);
+    }
+}
+
+void Spatializer::mixRampScalar(const float *in, float *out, int frames, float gain, float step)
+{
+    for (int i = 0; i < frames; i++) {
+        out[i] += in[i] * gain;
+        gain += step;
+    }
+}
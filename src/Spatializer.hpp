@@ -0,0 +1,74 @@
+#ifndef SPATIALIZER_HPP
+#define SPATIALIZER_HPP
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "al/io/al_AudioIOData.hpp"
+
+using namespace al;
+
+// Positions of the output channels' loudspeakers, as unit vectors
+// (x right, y up, z front).
+class SpeakerLayout {
+    public:
+        struct Speaker {
+            float x, y, z;
+        };
+
+        // n speakers evenly spaced on the horizontal circle, channel 0 in front
+        static SpeakerLayout ring(int n);
+        // Rings stacked from the horizon upwards, plus one at the zenith
+        static SpeakerLayout dome(int rings, int perRing);
+        static SpeakerLayout fromDegrees(const std::vector<float> &azimuth,
+                                         const std::vector<float> &elevation);
+
+        int size() const { return mSpeakers.size(); }
+        const Speaker &operator[](int i) const { return mSpeakers[i]; }
+
+        // Layout voices pan over when the device has more than two outputs.
+        // Set once before audio starts.
+        static void current(std::shared_ptr<const SpeakerLayout> layout);
+        static const SpeakerLayout *current();
+
+    private:
+        std::vector<Speaker> mSpeakers;
+};
+
+// Per-voice panning stage for N-channel output using distance-based
+// amplitude panning (DBAP). Gains are computed at control rate, once per
+// block in position(); mix() then ramps from the previous block's gains
+// to the new ones while adding the voice into every channel.
+class Spatializer {
+    public:
+        float rolloffDb = 6.f; // attenuation per doubling of distance
+        float blur = 0.2f;     // keeps a source on a speaker from collapsing to it
+
+        // Sizes the gain buffers, allocating only for more speakers than
+        // any layout before. Voices call it from init() with
+        // SpeakerLayout::current(), so the call in onProcess is free.
+        void layout(const SpeakerLayout *l);
+        const SpeakerLayout *layout() const { return mLayout; }
+
+        // Source direction in degrees (azimuth 0 = front, positive right)
+        // and distance relative to the speaker radius.
+        void position(float azimuth, float elevation = 0.f, float distance = 1.f);
+        // Fade in from silence on the next mix(), for a new note
+        void reset() { std::fill(mLastGains.begin(), mLastGains.end(), 0.f); }
+
+        // Add mono[0..frames) into io channels from frame `start` on.
+        void mix(const float *mono, int frames, AudioIOData &io, int start);
+
+        // Kernels: out[i] += in[i] * (gain + step * i). mixRamp uses SIMD
+        // when the target has it; mixRampScalar is the reference.
+        static void mixRamp(const float *in, float *out, int frames, float gain, float step);
+        static void mixRampScalar(const float *in, float *out, int frames, float gain, float step);
+
+    private:
+        const SpeakerLayout *mLayout = nullptr;
+        std::vector<float> mGains;     // target gains for this block
+        std::vector<float> mLastGains; // gains reached at the end of last block
+};
+
+#endif
@@ -0,0 +1,192 @@
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "StreamRecorder.hpp"
+
+namespace {
+    void put16(unsigned char *p, uint16_t v) { p[0] = v; p[1] = v >> 8; }
+    void put32(unsigned char *p, uint32_t v) { put16(p, v); put16(p + 2, v >> 16); }
+
+    bool endsWith(const std::string &s, const char *suffix) {
+        const size_t n = strlen(suffix);
+        return s.size() >= n && strcasecmp(s.c_str() + s.size() - n, suffix) == 0;
+    }
+
+    // Turn off O_DIRECT before a write that isn't block aligned
+    void buffered(int fd) {
+#ifdef O_DIRECT
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) & ~O_DIRECT);
+#endif
+    }
+}
+
+bool StreamRecorder::start(const std::string &path, int channels, double sampleRate)
+{
+    stop();
+    mWav = endsWith(path, ".wav");
+    mChannels = channels;
+    mSampleRate = sampleRate;
+    mDirect = false;
+
+    int flags = O_WRONLY | O_CREAT | O_TRUNC;
+#ifdef O_DIRECT
+    if (direct) {
+        mFd = open(path.c_str(), flags | O_DIRECT, 0644);
+        mDirect = mFd >= 0;
+        if (!mDirect) {
+            // e.g. tmpfs, which has no direct I/O
+            printf("recorder: O_DIRECT not supported for %s, using buffered writes\n", path.c_str());
+        }
+    }
+#endif
+    if (mFd < 0) {
+        mFd = open(path.c_str(), flags, 0644);
+    }
+    if (mFd < 0) {
+        printf("recorder: can't open %s: %s\n", path.c_str(), strerror(errno));
+        return false;
+    }
+#if defined(F_NOCACHE)
+    if (direct) {
+        mDirect = fcntl(mFd, F_NOCACHE, 1) == 0;
+    }
+#endif
+
+    void *buffer = nullptr;
+    if (posix_memalign(&buffer, kAlign, kWriteBytes) != 0) {
+        close(mFd);
+        mFd = -1;
+        return false;
+    }
+    mWriteBuffer = (float *)buffer;
+    mDataBytes = 0;
+    if (mWav) {
+        // Placeholder header, padded to a full block so that audio data
+        // stays aligned; sizes are filled in by stop()
+        writeHeader();
+        lseek(mFd, kAlign, SEEK_SET);
+    }
+
+    mRing.resize((size_t)(bufferSeconds * sampleRate) * channels);
+    mFramesWritten = 0;
+    mDroppedFrames = 0;
+    mRecording = true;
+    mWriter = std::thread(&StreamRecorder::run, this);
+    return true;
+}
+
+void StreamRecorder::stop()
+{
+    if (!mWriter.joinable()) {
+        return;
+    }
+    mRecording = false;
+    mWriter.join();
+    if (mWav) {
+        buffered(mFd);
+        writeHeader();
+    }
+    close(mFd);
+    mFd = -1;
+    free(mWriteBuffer);
+    mWriteBuffer = nullptr;
+}
+
+void StreamRecorder::process(const AudioIOData &io)
+{
+    if (!mRecording) {
+        return;
+    }
+    const int frames = io.framesPerBuffer();
+    if (mRing.writeAvailable() < (size_t)frames * mChannels) {
+        mDroppedFrames.fetch_add(frames, std::memory_order_relaxed);
+        return;
+    }
+    const int channels = std::min(mChannels, io.channelsOut());
+    for (int c = 0; c < mChannels; c++) {
+        const float *src = c < channels ? io.outBuffer(c) : nullptr;
+        for (int i = 0; i < frames; i++) {
+            mRing.writeSlot((size_t)i * mChannels + c) = src ? src[i] : 0.f;
+        }
+    }
+    mRing.commitWrite((size_t)frames * mChannels);
+}
+
+void StreamRecorder::run()
+{
+    const size_t capacity = kWriteBytes / sizeof(float);
+    size_t fill = 0;
+    while (true) {
+        // Checked before draining so the last blocks pushed are included
+        const bool stopping = !mRecording;
+        fill += mRing.read(mWriteBuffer + fill, capacity - fill);
+        if (fill == capacity) {
+            flush(kWriteBytes, false);
+            fill = 0;
+            continue;
+        }
+        if (stopping) {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    flush(fill * sizeof(float), true);
+}
+
+bool StreamRecorder::flush(size_t bytes, bool final)
+{
+    if (final && mDirect && bytes % kAlign != 0) {
+        buffered(mFd);
+    }
+    const char *p = (const char *)mWriteBuffer;
+    size_t left = bytes;
+    while (left > 0) {
+        const ssize_t n = write(mFd, p, left);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            printf("recorder: write failed: %s\n", strerror(errno));
+            mDroppedFrames += left / (sizeof(float) * mChannels);
+            return false;
+        }
+        p += n;
+        left -= n;
+        mDataBytes += n;
+    }
+    mFramesWritten = mDataBytes / (sizeof(float) * mChannels);
+    return true;
+}
+
+void StreamRecorder::writeHeader()
+{
+    // RIFF, fmt (IEEE float) and a JUNK chunk filling the block, so the
+    // data chunk header ends exactly at kAlign
+    unsigned char *h = (unsigned char *)mWriteBuffer;
+    memset(h, 0, kAlign);
+    const uint32_t dataBytes = mDataBytes > 0xffffffffu - kAlign ? 0xffffffffu - kAlign : mDataBytes;
+    memcpy(h, "RIFF", 4);
+    put32(h + 4, kAlign - 8 + dataBytes);
+    memcpy(h + 8, "WAVE", 4);
+    memcpy(h + 12, "fmt ", 4);
+    put32(h + 16, 16);
+    put16(h + 20, 3); // WAVE_FORMAT_IEEE_FLOAT
+    put16(h + 22, mChannels);
+    put32(h + 24, (uint32_t)mSampleRate);
+    put32(h + 28, (uint32_t)mSampleRate * mChannels * sizeof(float));
+    put16(h + 32, mChannels * sizeof(float));
+    put16(h + 34, 32);
+    memcpy(h + 36, "JUNK", 4);
+    put32(h + 40, kAlign - 52);
+    memcpy(h + kAlign - 8, "data", 4);
+    put32(h + kAlign - 4, dataBytes);
+    if (pwrite(mFd, h, kAlign, 0) != (ssize_t)kAlign) {
+        printf("recorder: can't write WAV header: %s\n", strerror(errno));
+    }
+}
@@ -0,0 +1,68 @@
+#ifndef STREAMRECORDER_HPP
+#define STREAMRECORDER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+#include "al/io/al_AudioIOData.hpp"
+
+#include "RingBuffer.hpp"
+
+using namespace al;
+
+// Records the device output to disk. process() runs at the end of the
+// audio callback and only copies the block into a ring buffer; a
+// background thread drains the ring in large sequential writes. If the
+// disk falls behind and the ring fills, whole blocks are dropped and
+// counted rather than ever making the audio thread wait.
+//
+// Files ending in .wav get a 32-bit float WAV header, anything else is
+// written as raw interleaved floats. With `direct` set the file is opened
+// with O_DIRECT (F_NOCACHE on macOS) so archiving long performances
+// doesn't push everything else out of the page cache.
+class StreamRecorder {
+    public:
+        double bufferSeconds = 4.0; // ring size
+        bool direct = false;
+
+        ~StreamRecorder() { stop(); }
+
+        // Open the file and start the writer thread. Returns false if
+        // the file can't be created.
+        bool start(const std::string &path, int channels, double sampleRate);
+        // Flush what's buffered, finish the header and close the file
+        void stop();
+        bool recording() const { return mRecording; }
+
+        // Audio thread
+        void process(const AudioIOData &io);
+
+        uint64_t framesWritten() const { return mFramesWritten; }
+        uint64_t droppedFrames() const { return mDroppedFrames; }
+
+    private:
+        static const size_t kWriteBytes = 1 << 20; // per write(), a multiple of kAlign
+        static const size_t kAlign = 4096;         // O_DIRECT buffer, size and offset alignment
+
+        void run();
+        bool flush(size_t bytes, bool final);
+        void writeHeader();
+
+        RingBuffer<float> mRing;
+        std::thread mWriter;
+        std::atomic<bool> mRecording{false};
+        std::atomic<uint64_t> mFramesWritten{0};
+        std::atomic<uint64_t> mDroppedFrames{0};
+
+        int mFd = -1;
+        bool mWav = false;
+        bool mDirect = false;
+        int mChannels = 0;
+        double mSampleRate = 0;
+        float *mWriteBuffer = nullptr; // kAlign aligned
+        uint64_t mDataBytes = 0;       // audio bytes written after the header
+};
+
+#endif
@@ -0,0 +1,80 @@
+#include <algorithm>
+#include <cmath>
+
+#include "TempoMap.hpp"
+
+namespace {
+    int64_t gcd(int64_t a, int64_t b)
+    {
+        while (b != 0) {
+            const int64_t t = a % b;
+            a = b;
+            b = t;
+        }
+        return a;
+    }
+
+    // a * num / den, rounded down, without overflowing for any tick count
+    // a session reaches: num / den is reduced, so r * num stays in range
+    int64_t mulDiv(int64_t a, int64_t num, int64_t den)
+    {
+        return a / den * num + a % den * num / den;
+    }
+}
+
+TempoMap::TempoMap(double sampleRate, double bpm) : mSampleRate(std::llround(sampleRate))
+{
+    setTempo(0, bpm);
+}
+
+void TempoMap::setTempo(double beat, double bpm)
+{
+    const int64_t tick = std::max<int64_t>(0, ticks(beat));
+    const int64_t bpmMilli = std::max<int64_t>(1, std::llround(bpm * 1000.));
+    auto it = std::lower_bound(mSegments.begin(), mSegments.end(), tick,
+                               [](const Segment &s, int64_t t) { return s.tick < t; });
+    if (it != mSegments.end() && it->tick == tick) {
+        it->bpmMilli = bpmMilli;
+    } else {
+        mSegments.insert(it, Segment{tick, 0, bpmMilli, 1, 1});
+    }
+    update();
+}
+
+int64_t TempoMap::ticks(double beat) { return std::llround(beat * kTicksPerBeat); }
+
+int64_t TempoMap::frame(int64_t tick) const
+{
+    if (tick <= 0) {
+        return 0;
+    }
+    auto it = std::upper_bound(mSegments.begin(), mSegments.end(), tick,
+                               [](int64_t t, const Segment &s) { return t < s.tick; });
+    const Segment &s = *(it - 1);
+    return s.frame + mulDiv(tick - s.tick, s.num, s.den);
+}
+
+void TempoMap::update()
+{
+    // A tempo before the first change holds from beat 0
+    if (mSegments.front().tick != 0) {
+        Segment first = mSegments.front();
+        first.tick = 0;
+        mSegments.insert(mSegments.begin(), first);
+    }
+    int64_t frame = 0;
+    for (size_t i = 0; i < mSegments.size(); i++) {
+        Segment &s = mSegments[i];
+        // 60 s * rate * 1000 / (bpm * 1000 * ticks per beat)
+        const int64_t num = 60 * mSampleRate * 1000;
+        const int64_t den = s.bpmMilli * kTicksPerBeat;
+        const int64_t g = gcd(num, den);
+        s.num = num / g;
+        s.den = den / g;
+        if (i > 0) {
+            const Segment &prev = mSegments[i - 1];
+            frame = prev.frame + mulDiv(s.tick - prev.tick, prev.num, prev.den);
+        }
+        s.frame = frame;
+    }
+}
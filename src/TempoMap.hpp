@@ -0,0 +1,42 @@
+#ifndef TEMPOMAP_HPP
+#define TEMPOMAP_HPP
+
+#include <cstdint>
+#include <vector>
+
+// Exact conversion between beats and a 64-bit sample clock. Beats are
+// counted in integer ticks; within a tempo segment, frames per tick is
+// kept as a reduced fraction (the tempo is stored to 1/1000 BPM), so a
+// tick maps to floor(tick * num / den) frames past the segment start
+// with no rounding error carried from one note, loop or segment to the
+// next. Timing is as exact after weeks of uptime as after a second.
+class TempoMap {
+    public:
+        static const int kTicksPerBeat = 960; // exact for the score's dashes
+
+        explicit TempoMap(double sampleRate = 48000., double bpm = 120.);
+
+        // Tempo from `beat` on. Replaces any change at the same beat.
+        void setTempo(double beat, double bpm);
+        double sampleRate() const { return (double)mSampleRate; }
+
+        static int64_t ticks(double beat);
+        int64_t frame(int64_t tick) const;
+        int64_t frameAtBeat(double beat) const { return frame(ticks(beat)); }
+        double secondsAtBeat(double beat) const { return frameAtBeat(beat) / (double)mSampleRate; }
+
+    private:
+        struct Segment {
+            int64_t tick;
+            int64_t frame;    // frame at tick
+            int64_t bpmMilli;
+            int64_t num, den; // frames per tick
+        };
+
+        void update();
+
+        int64_t mSampleRate;
+        std::vector<Segment> mSegments; // sorted by tick, first at 0
+};
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef TUNING_HPP
+#define TUNING_HPP
+
+// Compile-time tuning tables. A TuningTable maps MIDI note numbers to
+// frequencies for a 12-note scale anchored at a reference pitch; tables
+// declared constexpr are computed by the compiler, so looking up a note
+// is a single load instead of a pow(). There are no tables of phase
+// increments: voices take a frequency trigger parameter, and their
+// oscillators turn it into an increment once per block.
+
+// Frequency ratios of the 12 scale degrees above the tonic
+struct ScaleRatios {
+    double ratio[12];
+};
+
+// 2^(k/12)
+constexpr ScaleRatios kEqualTemperament = {{
+    1.0, 1.0594630943592953, 1.122462048309373, 1.189207115002721,
+    1.2599210498948732, 1.3348398541700344, 1.4142135623730951, 1.4983070768766815,
+    1.5874010519681994, 1.681792830507429, 1.7817974362806785, 1.887748625363387,
+}};
+
+// 5-limit just intonation
+constexpr ScaleRatios kJustIntonation = {{
+    1.0, 16.0 / 15.0, 9.0 / 8.0, 6.0 / 5.0, 5.0 / 4.0, 4.0 / 3.0,
+    45.0 / 32.0, 3.0 / 2.0, 8.0 / 5.0, 5.0 / 3.0, 9.0 / 5.0, 15.0 / 8.0,
+}};
+
+// Pythagorean, built from pure fifths
+constexpr ScaleRatios kPythagorean = {{
+    1.0, 256.0 / 243.0, 9.0 / 8.0, 32.0 / 27.0, 81.0 / 64.0, 4.0 / 3.0,
+    729.0 / 512.0, 3.0 / 2.0, 128.0 / 81.0, 27.0 / 16.0, 16.0 / 9.0, 243.0 / 128.0,
+}};
+
+class TuningTable {
+    public:
+        static const int kNotes = 128;
+
+        // referenceHz is the frequency of referenceNote (A4 = 69 by
+        // default). The scale is built on pitch class tonic (0 = C,
+        // 9 = A), which only matters for scales other than equal temperament.
+        constexpr TuningTable(double referenceHz, const ScaleRatios &scale = kEqualTemperament,
+                              int tonic = 9, int referenceNote = 69)
+            : mFreqs{}
+        {
+            // The tonic at or below the reference note
+            const int tonicNote = referenceNote - mod12(referenceNote - tonic);
+            const double tonicHz = referenceHz / scale.ratio[referenceNote - tonicNote];
+            for (int note = 0; note < kNotes; note++) {
+                const int steps = note - tonicNote;
+                const int degree = mod12(steps);
+                const int octave = (steps - degree) / 12;
+                mFreqs[note] = (float)(tonicHz * scale.ratio[degree] * pow2(octave));
+            }
+        }
+
+        constexpr float freq(int note) const {
+            return mFreqs[note < 0 ? 0 : note >= kNotes ? kNotes - 1 : note];
+        }
+
+    private:
+        static constexpr int mod12(int n) { return ((n % 12) + 12) % 12; }
+
+        static constexpr double pow2(int n) {
+            double r = 1.0;
+            for (; n > 0; n--) r *= 2.0;
+            for (; n < 0; n++) r *= 0.5;
+            return r;
+        }
+
+        float mFreqs[kNotes];
+};
+
+// Tunings used by the apps
+constexpr TuningTable kConcertPitch(440.0);   // notedefs.hpp, the score
+constexpr TuningTable kVerdiPitch(432.0);     // oscServer keyboard
+
+#endif
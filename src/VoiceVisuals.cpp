@@ -0,0 +1,197 @@
+#include <algorithm>
+#include <cmath>
+
+#include "AdditiveEnv.hpp"
+#include "SineEnv.hpp"
+#include "VoiceVisuals.hpp"
+#include "WavetableEnv.hpp"
+
+namespace {
+    const int kSlices[] = {30, 12, 6};
+    const int kLevelVoices[] = {64, 256}; // above these, use the next level
+}
+
+void VoiceVisuals::init()
+{
+    for (int l = 0; l < kLevels; l++) {
+        mDiscs[l].reset();
+        addDisc(mDiscs[l], 1.0, kSlices[l]);
+    }
+}
+
+namespace {
+    template <class V>
+    float envelopeOf(const SynthVoice &voice) {
+        return static_cast<const V &>(voice).mAmpEnv.value();
+    }
+
+    int parameterIndex(SynthVoice &voice, const char *name) {
+        std::vector<ParameterMeta *> &params = voice.triggerParameters();
+        for (size_t i = 0; i < params.size(); i++) {
+            if (params[i]->getName() == name && dynamic_cast<Parameter *>(params[i])) {
+                return (int)i;
+            }
+        }
+        return -1;
+    }
+}
+
+VoiceVisuals::VoiceType VoiceVisuals::resolve(SynthVoice &voice)
+{
+    VoiceType t = {&typeid(voice), nullptr, parameterIndex(voice, "frequency"),
+                   parameterIndex(voice, "amplitude")};
+    if (dynamic_cast<SineEnv *>(&voice)) {
+        t.envelope = envelopeOf<SineEnv>;
+    } else if (dynamic_cast<WavetableEnv *>(&voice)) {
+        t.envelope = envelopeOf<WavetableEnv>;
+    } else if (dynamic_cast<AdditiveEnv *>(&voice)) {
+        t.envelope = envelopeOf<AdditiveEnv>;
+    }
+    if (t.frequency < 0 || t.amplitude < 0) {
+        t.envelope = nullptr;
+    }
+    return t;
+}
+
+const VoiceVisuals::VoiceType &VoiceVisuals::typeOf(SynthVoice &voice)
+{
+    const std::type_info *type = &typeid(voice);
+    for (int i = 0; i < mNumTypes; i++) {
+        if (mTypes[i].type == type) {
+            return mTypes[i];
+        }
+    }
+    if (mNumTypes == kMaxTypes) {
+        mUncached = resolve(voice);
+        return mUncached;
+    }
+    mTypes[mNumTypes] = resolve(voice);
+    return mTypes[mNumTypes++];
+}
+
+void VoiceVisuals::capture(PolySynth &synth)
+{
+    if (mSnapshot.load(std::memory_order_acquire) != kWanted) {
+        return;
+    }
+    int count = 0, voices = 0;
+    for (SynthVoice *voice = synth.getActiveVoices(); voice; voice = voice->next) {
+        voices++;
+        const VoiceType &type = typeOf(*voice);
+        if (!type.envelope || count == kMaxVoices) {
+            continue;
+        }
+        std::vector<ParameterMeta *> &params = voice->triggerParameters();
+        const float frequency = static_cast<Parameter *>(params[type.frequency])->get();
+        const float amplitude = static_cast<Parameter *>(params[type.amplitude])->get();
+        mCaptured[count++] = {frequency, amplitude, type.envelope(*voice) * amplitude};
+    }
+    mCapturedCount = count;
+    mCapturedVoices = voices;
+    mSnapshot.store(kReady, std::memory_order_release);
+}
+
+void VoiceVisuals::draw(Graphics &g, float width, float height, float fovyDegrees)
+{
+    if (mSnapshot.load(std::memory_order_acquire) == kReady) {
+        mStates.assign(mCaptured.begin(), mCaptured.begin() + mCapturedCount);
+        mStateVoices = mCapturedVoices;
+        mSnapshot.store(kWanted, std::memory_order_release);
+    }
+    mGlyphs.clear();
+    mVoices = mStateVoices;
+    mDrawn = mCulled = mMerged = 0;
+
+    // Visible half extents at the glyphs' depth, and pixels per world unit
+    const float depth = 8.f;
+    const float halfH = depth * std::tan(fovyDegrees * 0.5f * (float)M_PI / 180.f);
+    const float halfW = halfH * width / std::max(height, 1.f);
+    const float pixelsPerUnit = height / (2 * halfH);
+
+    for (const VoiceState &voice : mStates) {
+        const VoiceGlyph glyph = VoiceGlyph::make(voice.frequency, voice.amplitude, voice.level);
+        const float rx = std::abs(glyph.sx), ry = std::abs(glyph.sy);
+        if (glyph.x + rx < -halfW || glyph.x - rx > halfW || glyph.y + ry < -halfH ||
+            glyph.y - ry > halfH || 2 * std::max(rx, ry) * pixelsPerUnit < minPixels) {
+            mCulled++;
+            continue;
+        }
+        mGlyphs.push_back(glyph);
+    }
+
+    // Bin into screen cells; if that would still draw too much, merge
+    // every shared cell and then coarsen the grid until it fits
+    float cellSize = cellPixels;
+    int threshold = mergeThreshold;
+    for (int attempt = 0;; attempt++) {
+        const int gridW = std::max(1, (int)std::ceil(width / cellSize));
+        const int gridH = std::max(1, (int)std::ceil(height / cellSize));
+        mCells.assign(gridW * gridH, Cell{0, 0, 0, 0, 0, 0, 0, 0, 0});
+        mCellOf.resize(mGlyphs.size());
+        for (size_t i = 0; i < mGlyphs.size(); i++) {
+            const VoiceGlyph &v = mGlyphs[i];
+            const int cx = std::min(gridW - 1, std::max(0, (int)((v.x + halfW) * pixelsPerUnit / cellSize)));
+            const int cy = std::min(gridH - 1, std::max(0, (int)((halfH - v.y) * pixelsPerUnit / cellSize)));
+            const int c = cy * gridW + cx;
+            mCellOf[i] = c;
+            Cell &cell = mCells[c];
+            const float rx = std::abs(v.sx), ry = std::abs(v.sy);
+            if (cell.count++ == 0) {
+                cell.minX = v.x - rx; cell.maxX = v.x + rx;
+                cell.minY = v.y - ry; cell.maxY = v.y + ry;
+            } else {
+                cell.minX = std::min(cell.minX, v.x - rx); cell.maxX = std::max(cell.maxX, v.x + rx);
+                cell.minY = std::min(cell.minY, v.y - ry); cell.maxY = std::max(cell.maxY, v.y + ry);
+            }
+            cell.r += v.r; cell.g += v.g; cell.b += v.b; cell.a += v.a;
+        }
+
+        int draws = 0;
+        for (const Cell &cell : mCells) {
+            draws += cell.count > threshold ? 1 : cell.count;
+        }
+        if (draws <= maxDraws || attempt >= 8) {
+            break;
+        }
+        threshold = 1;
+        cellSize *= 2;
+    }
+
+    int level = 0;
+    while (level < kLevels - 1 && mVoices > kLevelVoices[level]) {
+        level++;
+    }
+    const Mesh &disc = mDiscs[level];
+
+    for (size_t i = 0; i < mGlyphs.size(); i++) {
+        if (mCells[mCellOf[i]].count > threshold) {
+            continue;
+        }
+        const VoiceGlyph &v = mGlyphs[i];
+        g.pushMatrix();
+        g.translate(v.x, v.y, v.z);
+        g.scale(v.sx, v.sy, 1);
+        g.color(v.r, v.g, v.b, v.a);
+        g.draw(disc);
+        g.popMatrix();
+        mDrawn++;
+    }
+
+    // One disc per crowded cell, spanning its voices
+    for (const Cell &cell : mCells) {
+        if (cell.count <= threshold) {
+            continue;
+        }
+        const float n = cell.count;
+        const float meanAlpha = cell.a / n;
+        g.pushMatrix();
+        g.translate((cell.minX + cell.maxX) / 2, (cell.minY + cell.maxY) / 2, -depth);
+        g.scale((cell.maxX - cell.minX) / 2, (cell.maxY - cell.minY) / 2, 1);
+        // The opacity n overlapping discs would have built up
+        g.color(cell.r / n, cell.g / n, cell.b / n, 1 - std::pow(1 - meanAlpha, n));
+        g.draw(disc);
+        g.popMatrix();
+        mDrawn++;
+        mMerged += cell.count;
+    }
+}
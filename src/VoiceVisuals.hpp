@@ -0,0 +1,121 @@
+#ifndef VOICEVISUALS_HPP
+#define VOICEVISUALS_HPP
+
+#include <atomic>
+#include <typeinfo>
+#include <vector>
+
+#include "al/graphics/al_Graphics.hpp"
+#include "al/graphics/al_Shapes.hpp"
+#include "al/scene/al_PolySynth.hpp"
+
+using namespace al;
+
+// Where and how a voice's disc is drawn: frequency sets x, amplitude sets
+// y and the disc's aspect, the current level (envelope times amplitude)
+// sets the colour. Used by
+// the voices' own onProcess(Graphics &) and by VoiceVisuals.
+struct VoiceGlyph {
+    float x, y, z;
+    float sx, sy;
+    float r, g, b, a;
+
+    static VoiceGlyph make(float frequency, float amplitude, float env) {
+        return {frequency / 200 - 3, amplitude, -8, 1 - amplitude, amplitude,
+                env, frequency / 1000, env * 10, 0.4f};
+    }
+};
+
+// Level-of-detail stage for drawing the active voices in place of
+// SynthGUIManager::render(Graphics &). Per frame, on the CPU:
+//  - voices whose disc is off screen or smaller than minPixels are culled
+//  - voices are binned into cellPixels screen cells; a cell holding more
+//    than mergeThreshold voices is drawn as one aggregate disc covering
+//    them, with their mean colour and summed opacity
+//  - disc tessellation drops as the number of voices grows
+// so the draw count stays under maxDraws however many voices are active.
+//
+// The synth's voice list belongs to the audio thread, so capture() reads
+// the voices there, at most once per drawn frame, and hands draw() a
+// snapshot of their frequency, amplitude and level without locking.
+// How to read a voice is resolved once per voice type, so the audio
+// thread does no casts or name lookups per voice. Voice types without a
+// disc (SampleVoice) are counted but not drawn.
+class VoiceVisuals {
+    public:
+        static const int kMaxVoices = 4096; // per snapshot
+
+        float minPixels = 0.5f;
+        float cellPixels = 12.f;
+        int mergeThreshold = 3;
+        int maxDraws = 512;
+
+        // Build the disc meshes; call from onCreate
+        void init();
+
+        // Audio thread, after the synth has rendered: snapshot the active
+        // voices if draw() has taken the last snapshot
+        void capture(PolySynth &synth);
+
+        // Draw the newest snapshot. Camera assumed at the origin looking
+        // down -z, as the apps use it
+        void draw(Graphics &g, float width, float height, float fovyDegrees);
+
+        // Counts from the last draw()
+        int voices() const { return mVoices; }
+        int drawn() const { return mDrawn; }
+        int culled() const { return mCulled; }
+        int merged() const { return mMerged; }
+
+    private:
+        struct VoiceState {
+            float frequency;
+            float amplitude;
+            float level; // envelope times amplitude
+        };
+
+        // How capture() reads voices of one type: its envelope, or null for
+        // voices without a disc, and its parameters' trigger indices
+        struct VoiceType {
+            const std::type_info *type;
+            float (*envelope)(const SynthVoice &);
+            int frequency, amplitude;
+        };
+
+        struct Cell {
+            int count;
+            float minX, maxX, minY, maxY; // world units at the glyph's depth
+            float r, g, b, a;
+        };
+
+        // Slices per disc from fine to coarse, and the voice counts
+        // above which each coarser one is used
+        static const int kLevels = 3;
+        Mesh mDiscs[kLevels];
+
+        static VoiceType resolve(SynthVoice &voice);
+        const VoiceType &typeOf(SynthVoice &voice);
+
+        // Voice types seen so far, audio thread only
+        static const int kMaxTypes = 8;
+        VoiceType mTypes[kMaxTypes];
+        int mNumTypes = 0;
+        VoiceType mUncached; // once mTypes is full
+
+        // Snapshot handoff: the audio thread fills mCaptured while
+        // mSnapshot is kWanted, then sets it to kReady for draw() to copy
+        enum { kWanted, kReady };
+        std::atomic<int> mSnapshot{kWanted};
+        std::vector<VoiceState> mCaptured = std::vector<VoiceState>(kMaxVoices);
+        int mCapturedCount = 0;
+        int mCapturedVoices = 0;
+        std::vector<VoiceState> mStates; // graphics thread's copy
+        int mStateVoices = 0;
+
+        std::vector<VoiceGlyph> mGlyphs;
+        std::vector<int> mCellOf;
+        std::vector<Cell> mCells;
+        int mVoices = 0, mDrawn = 0, mCulled = 0, mMerged = 0;
+};
+
+#endif
@@ -0,0 +1,170 @@
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+
+#include "Wavetable.hpp"
+
+namespace {
+    // One cycle of a sine at table resolution. Harmonic k of sample i is
+    // read at index (k * i) mod kSize, so building a level needs no sin().
+    const std::vector<float> &sineCycle() {
+        static const std::vector<float> table = [] {
+            std::vector<float> t(Wavetable::kSize);
+            for (int i = 0; i < Wavetable::kSize; i++) {
+                t[i] = (float)std::sin(2.0 * M_PI * i / Wavetable::kSize);
+            }
+            return t;
+        }();
+        return table;
+    }
+}
+
+Wavetable::Wavetable(const std::vector<float> &sines, const std::vector<float> &cosines)
+    : mSines(sines), mCosines(cosines)
+{
+    const int n = std::max(mSines.size(), mCosines.size());
+    mSines.resize(n, 0.f);
+    mCosines.resize(n, 0.f);
+    mData.assign(kLevels * kStride, 0.f);
+
+    const std::vector<float> &s = sineCycle();
+    const int mask = kSize - 1;
+    const int quarter = kSize / 4;
+
+    // Levels differ only by their highest harmonics, so build from the
+    // sparsest level down, adding partials into a running sum.
+    std::vector<double> sum(kSize, 0.0);
+    int built = 0;
+    for (int l = kLevels - 1; l >= 0; l--) {
+        const int harmonics = std::min(n, (kSize / 2) >> l);
+        for (int k = built + 1; k <= harmonics; k++) {
+            const float a = mSines[k - 1];
+            const float b = mCosines[k - 1];
+            if (a == 0.f && b == 0.f) {
+                continue;
+            }
+            for (int i = 0; i < kSize; i++) {
+                const int j = k * i;
+                sum[i] += a * s[j & mask] + b * s[(j + quarter) & mask];
+            }
+        }
+        built = std::max(built, harmonics);
+
+        double peak = 0.0;
+        for (int i = 0; i < kSize; i++) {
+            peak = std::max(peak, std::fabs(sum[i]));
+        }
+        const double norm = peak > 0.0 ? 1.0 / peak : 0.0;
+
+        float *t = &mData[l * kStride + 1];
+        for (int i = 0; i < kSize; i++) {
+            t[i] = (float)(sum[i] * norm);
+        }
+        t[-1] = t[kSize - 1];
+        t[kSize] = t[0];
+        t[kSize + 1] = t[1];
+    }
+}
+
+std::shared_ptr<const Wavetable> Wavetable::fromCycle(const std::vector<float> &cycle)
+{
+    const int len = cycle.size();
+    const int n = std::min(len / 2, kSize / 2);
+    std::vector<float> sines(n), cosines(n);
+    for (int k = 1; k <= n; k++) {
+        double a = 0.0, b = 0.0;
+        for (int i = 0; i < len; i++) {
+            const double w = 2.0 * M_PI * k * i / len;
+            a += cycle[i] * std::sin(w);
+            b += cycle[i] * std::cos(w);
+        }
+        sines[k - 1] = (float)(2.0 * a / len);
+        cosines[k - 1] = (float)(2.0 * b / len);
+    }
+    return std::make_shared<const Wavetable>(sines, cosines);
+}
+
+std::shared_ptr<const Wavetable> Wavetable::get(Waveform w)
+{
+    static std::shared_ptr<const Wavetable> tables[NUM_WAVEFORMS];
+    static std::once_flag once[NUM_WAVEFORMS];
+    if (w < 0 || w >= NUM_WAVEFORMS) {
+        w = SINE;
+    }
+    std::call_once(once[w], [w] {
+        const int n = kSize / 2;
+        std::vector<float> h(n, 0.f);
+        switch (w) {
+            case SINE:
+                h.resize(1);
+                h[0] = 1.f;
+                break;
+            case TRIANGLE:
+                for (int k = 1; k <= n; k += 2) {
+                    h[k - 1] = (((k - 1) / 2) % 2 ? -1.f : 1.f) / (k * k);
+                }
+                break;
+            case SQUARE:
+                for (int k = 1; k <= n; k += 2) {
+                    h[k - 1] = 1.f / k;
+                }
+                break;
+            default: // SAW
+                for (int k = 1; k <= n; k++) {
+                    h[k - 1] = (k % 2 ? 1.f : -1.f) / k;
+                }
+                break;
+        }
+        tables[w] = std::make_shared<const Wavetable>(h);
+    });
+    return tables[w];
+}
+
+void Wavetable::prewarm()
+{
+    for (int w = 0; w < NUM_WAVEFORMS; w++) {
+        get((Waveform)w);
+    }
+}
+
+int Wavetable::levelFor(float increment)
+{
+    // Level l holds (kSize / 2) >> l harmonics, which stay below Nyquist
+    // while increment * kSize <= 2^l.
+    float x = std::fabs(increment) * kSize;
+    int l = 0;
+    while (x > 1.f && l < kLevels - 1) {
+        x *= 0.5f;
+        l++;
+    }
+    return l;
+}
+
+void WavetableOsc::freq(float hz, float sampleRate)
+{
+    const double cycles = std::min(std::fabs((double)hz / sampleRate), 0.5);
+    mCyclesPerSample = (float)cycles;
+    mIncrement = (uint32_t)(int64_t)(cycles * 4294967296.0);
+    update();
+}
+
+void WavetableOsc::update()
+{
+    mLevel = mTable ? mTable->level(Wavetable::levelFor(mCyclesPerSample)) : nullptr;
+}
+
+void WavetableOsc::render(float *out, int n)
+{
+    if (mInterp == LINEAR) {
+        for (int k = 0; k < n; k++) {
+            const uint32_t i = mPhase >> kFracBits;
+            const float f = (mPhase & kFracMask) * kFracScale;
+            out[k] = mLevel[i] + f * (mLevel[i + 1] - mLevel[i]);
+            mPhase += mIncrement;
+        }
+    } else {
+        for (int k = 0; k < n; k++) {
+            out[k] = (*this)();
+        }
+    }
+}
@@ -0,0 +1,102 @@
+#ifndef WAVETABLE_HPP
+#define WAVETABLE_HPP
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// A band-limited, mipmapped single-cycle wavetable. Level 0 holds every
+// harmonic that fits in the table; each following level holds half as many,
+// so the oscillator can pick the richest level that does not alias at the
+// current pitch. Tables are immutable once built and are meant to be shared
+// between all voices that play the same waveform.
+class Wavetable {
+    public:
+        static const int kSizeBits = 11;
+        static const int kSize = 1 << kSizeBits;      // samples per cycle
+        static const int kLevels = kSizeBits;         // 1024, 512, ... 1 harmonics
+        static const int kGuard = 3;                  // 1 point before, 2 after
+
+        enum Waveform { SINE = 0, TRIANGLE, SQUARE, SAW, NUM_WAVEFORMS };
+
+        // Build from harmonic amplitudes: sines[k] is the sine-phase amplitude
+        // of partial k + 1 and cosines[k] its cosine-phase amplitude. Every
+        // level is normalized to a peak of 1.
+        explicit Wavetable(const std::vector<float> &sines,
+                           const std::vector<float> &cosines = std::vector<float>());
+
+        // Build from one cycle of an arbitrary waveform of any length. The
+        // cycle is analysed once and rebuilt band-limited at each level.
+        static std::shared_ptr<const Wavetable> fromCycle(const std::vector<float> &cycle);
+
+        // Shared tables for the built-in waveforms, created on first use.
+        static std::shared_ptr<const Wavetable> get(Waveform w);
+        // Build every built-in table now, so that no get() from the audio
+        // thread has to.
+        static void prewarm();
+
+        // Level to use for a phase increment in cycles per sample.
+        static int levelFor(float increment);
+
+        // Pointer to sample 0 of a level; indices -1 .. kSize + 1 are valid.
+        const float *level(int l) const { return &mData[l * kStride + 1]; }
+
+        int numHarmonics() const { return (int)mSines.size(); }
+
+    private:
+        static const int kStride = kSize + kGuard;
+
+        std::vector<float> mSines;
+        std::vector<float> mCosines;
+        std::vector<float> mData;
+};
+
+// Phase accumulator reading a shared Wavetable with linear or cubic
+// interpolation. The phase is 32-bit fixed point so wrap-around is free.
+class WavetableOsc {
+    public:
+        enum Interpolation { LINEAR = 0, CUBIC };
+
+        void table(std::shared_ptr<const Wavetable> t) { mTable = std::move(t); update(); }
+        void interpolation(Interpolation i) { mInterp = i; }
+        Interpolation interpolation() const { return mInterp; }
+
+        // Set frequency for the given sample rate. Picks the mip level, so
+        // call it at control rate rather than per sample.
+        void freq(float hz, float sampleRate);
+        void phase(float cycles) { mPhase = (uint32_t)(int64_t)(cycles * 4294967296.0); }
+
+        float operator()() {
+            const uint32_t i = mPhase >> kFracBits;
+            const float f = (mPhase & kFracMask) * kFracScale;
+            const float *t = mLevel + i;
+            mPhase += mIncrement;
+            if (mInterp == LINEAR) {
+                return t[0] + f * (t[1] - t[0]);
+            }
+            // 4-point, 3rd-order Hermite
+            const float c1 = 0.5f * (t[1] - t[-1]);
+            const float c2 = t[-1] - 2.5f * t[0] + 2.f * t[1] - 0.5f * t[2];
+            const float c3 = 0.5f * (t[2] - t[-1]) + 1.5f * (t[0] - t[1]);
+            return ((c3 * f + c2) * f + c1) * f + t[0];
+        }
+
+        // Render n samples into out, overwriting it.
+        void render(float *out, int n);
+
+    private:
+        static const int kFracBits = 32 - Wavetable::kSizeBits;
+        static const uint32_t kFracMask = (1u << kFracBits) - 1;
+        static constexpr float kFracScale = 1.f / (1u << kFracBits);
+
+        void update();
+
+        std::shared_ptr<const Wavetable> mTable;
+        const float *mLevel = nullptr;
+        uint32_t mPhase = 0;
+        uint32_t mIncrement = 0;
+        float mCyclesPerSample = 0;
+        Interpolation mInterp = LINEAR;
+};
+
+#endif
@@ -0,0 +1,101 @@
+#include <algorithm>
+
+#include "WavetableEnv.hpp"
+#include "VoiceVisuals.hpp"
+
+void WavetableEnv::init()
+{
+    // Intialize envelope (LinearEnv segments are always straight lines)
+    mAmpEnv.levels(0, 1, 1, 0);
+    mAmpEnv.sustainPoint(2); // Make point 2 sustain until a release is issued
+    // Gains for the speaker layout, allocated now rather than in onProcess
+    mSpatial.layout(SpeakerLayout::current());
+
+    addDisc(mMesh, 1.0, 30);
+    // The tables onProcess switches between, built before any voice plays
+    Wavetable::prewarm();
+
+    // Same trigger parameters as SineEnv, so the two voices are
+    // interchangeable in playNote() and in presets, plus the table choice.
+    createInternalTriggerParameter("amplitude", 0.25, 0.0, 1.0);
+    createInternalTriggerParameter("frequency", 60, 20, 5000);
+    createInternalTriggerParameter("attackTime", 1.0 / 77.0, 0.01, 3.0);
+    createInternalTriggerParameter("releaseTime", 1.0 / 77.0, 0.1, 10.0);
+    createInternalTriggerParameter("decayTime", 2.0 / 77.0, 0.1, 10.0);
+    createInternalTriggerParameter("pan", 0.0, -1.0, 1.0);
+    // Wavetable::Waveform and WavetableOsc::Interpolation
+    createInternalTriggerParameter("waveform", Wavetable::SAW, 0, Wavetable::NUM_WAVEFORMS - 1);
+    createInternalTriggerParameter("interpolation", WavetableOsc::LINEAR, 0, 1);
+}
+
+void WavetableEnv::onProcess(AudioIOData &io)
+{
+    int waveform = (int)getInternalParameterValue("waveform");
+    if (waveform != mWaveform) {
+        mWaveform = waveform;
+        mOsc.table(Wavetable::get((Wavetable::Waveform)waveform));
+    }
+    mOsc.interpolation((WavetableOsc::Interpolation)(int)getInternalParameterValue("interpolation"));
+    mOsc.freq(getInternalParameterValue("frequency"), io.framesPerSecond());
+    mAmpEnv.sampleRate(io.framesPerSecond());
+    mAmpEnv.lengths()[0] = getInternalParameterValue("attackTime");
+    mAmpEnv.lengths()[2] = getInternalParameterValue("releaseTime");
+    mPan.pos(getInternalParameterValue("pan"));
+    float amp = getInternalParameterValue("amplitude");
+    // Oscillator and envelope both render a chunk at a time
+    float osc[kChunk], env[kChunk];
+    const int end = io.framesPerBuffer();
+    const SpeakerLayout *layout = SpeakerLayout::current();
+    const bool spatial = layout && io.channelsOut() > 2;
+    if (spatial) {
+        mSpatial.layout(layout);
+        mSpatial.position(getInternalParameterValue("pan") * 180.f);
+    }
+    for (int start = io.frame() + 1; start < end; start += kChunk)
+    {
+        const int n = std::min(kChunk, end - start);
+        mOsc.render(osc, n);
+        mAmpEnv.process(env, n);
+        if (spatial) {
+            for (int i = 0; i < n; i++)
+            {
+                osc[i] *= env[i] * amp;
+            }
+            mSpatial.mix(osc, n, io, start);
+            continue;
+        }
+        for (int i = 0; i < n; i++)
+        {
+            float s1 = osc[i] * env[i] * amp;
+            float s2;
+            mPan(s1, s1, s2);
+            io.out(0, start + i) += s1;
+            io.out(1, start + i) += s2;
+        }
+    }
+    if (mAmpEnv.done())
+        free();
+}
+
+void WavetableEnv::onProcess(Graphics &g)
+{
+    float frequency = getInternalParameterValue("frequency");
+    float amplitude = getInternalParameterValue("amplitude");
+    g.pushMatrix();
+    const VoiceGlyph v = VoiceGlyph::make(frequency, amplitude, mAmpEnv.value() * amplitude);
+    g.translate(v.x, v.y, v.z);
+    g.scale(v.sx, v.sy, 1);
+    g.color(v.r, v.g, v.b, v.a);
+    g.draw(mMesh);
+    g.popMatrix();
+}
+
+void WavetableEnv::onTriggerOn()
+{
+    mOsc.phase(0);
+    mAmpEnv.reset();
+    // Start from silence rather than ramping from the last note's position
+    mSpatial.reset();
+}
+
+void WavetableEnv::onTriggerOff() { mAmpEnv.release(); }
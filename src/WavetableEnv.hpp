@@ -0,0 +1,52 @@
+#ifndef WAVETABLEENV_HPP
+#define WAVETABLEENV_HPP
+
+#include "Gamma/Analysis.h"
+#include "Gamma/Effects.h"
+#include "Gamma/Envelope.h"
+
+#include "al/app/al_App.hpp"
+#include "al/graphics/al_Shapes.hpp"
+#include "al/scene/al_PolySynth.hpp"
+#include "al/scene/al_SynthSequencer.hpp"
+#include "al/ui/al_Parameter.hpp"
+
+#include "LinearEnv.hpp"
+#include "Spatializer.hpp"
+#include "Wavetable.hpp"
+
+using namespace al;
+
+// Drop-in alternative to SineEnv that reads its oscillator from a shared,
+// band-limited wavetable, so richer waveforms cost the same as a sine.
+class WavetableEnv : public SynthVoice {
+    public:
+        // Unit generators
+        gam::Pan<> mPan;
+        WavetableOsc mOsc;
+        LinearEnv<3> mAmpEnv;
+        // Used instead of mPan when the device has more than two outputs
+        Spatializer mSpatial;
+
+        // Additional members
+        Mesh mMesh;
+        int mWaveform = -1;
+
+        // Samples rendered per pass of the audio loop
+        static const int kChunk = 64;
+
+        // Initialize voice. This function will only be called once per voice when
+        // it is created. Voices will be reused if they are idle.
+        void init() override;
+
+        // The audio processing function
+        void onProcess(AudioIOData& io) override;
+
+        // The graphics processing function
+        void onProcess(Graphics& g) override;
+
+        void onTriggerOn() override;
+        void onTriggerOff() override;
+};
+
+#endif
@@ -11,127 +11,43 @@
 #include "al/ui/al_ControlGUI.hpp"
 #include "al/ui/al_Parameter.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <string>
 #include <vector>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
 
 // using namespace gam;
 using namespace al;
 
 
 #include "notedefs.hpp"
-
-const float dashLength = 1.f / 6.f;
-const float BPM = 77.f;
-const float wholeNote = 240.f / BPM * 1000.f;
-const float halfNote = wholeNote / 2.f;
-const float quarterNote = wholeNote / 4.f;
-const float eighthNote = quarterNote / 2.f;
-const float sixteenthNote = eighthNote / 2.f;
-const float dottedHalfNote = halfNote * 1.5f;
-const float dottedQuarterNote = quarterNote * 1.5f;
-const float dottedEighthNote = dottedQuarterNote / 2.f;
-const float dottedSixteenthNote = dottedEighthNote / 2.f;
-const float amplitude = 0.25f;
+#include "Score.hpp"
 
 #include "SineEnv.hpp"
-
-class TimeSignature {
-    private:
-        int upper;
-        int lower;
-
-    public:
-        TimeSignature() {
-            this->upper = 4;
-            this->lower = 4;
-        }
-};
-
-class Note {
-    private:
-        float freq;
-        float time;
-        float duration;
-        float amp;
-        float attack;
-        float release;
-        float decay;
-        float sustain;
-    
-    public:
-        Note() {
-            this->freq = 440.0;
-            this->time = 0;
-            this->duration = 0.5;
-            this->amp = 0.2;
-            this->attack = 0.05;
-            this->release = 0.05;
-            this->decay = 0.5;
-            this->sustain = 0.05;
-        }
-        Note(float freq, float time = 0.0f, float duration = 0.5f, float amp = 0.2f, float attack = 0.05f, float release = 0.05f, float decay = 0.5f, float sustain = 0.05f) {
-            this->freq = freq;
-            this->time = time;
-            this->duration = duration;
-            this->amp = amp;
-            this->attack = attack;
-            this->release = release;
-            this->decay = decay;
-            this->sustain = sustain;
-        }
-        // Return an identical note, but offset by the
-        // number of beats indicated by beatOffset,
-        // and with amplitude multiplied by ampMult
-        Note(const Note &n, float beatOffset, float ampMult = 1.0f) {
-            this->freq = n.freq;
-            this->time = n.time + beatOffset;
-            this->duration = n.duration;
-            this->amp = n.amp * ampMult;
-            this->attack = n.attack;
-            this->release = n.release;
-            this->decay = n.decay;
-            this->sustain = n.sustain;
-        }
-        Note(const Note &n) {
-            this->freq = n.freq;
-            this->time = n.time;
-            this->duration = n.duration;
-            this->amp = n.amp;
-            this->attack = n.attack;
-            this->release = n.release;
-            this->decay = n.decay;
-            this->sustain = n.sustain;
-        }
-        float getFreq() { return this->freq; }
-        float getTime() { return this->time; }
-        float getDuration() { return this->duration; }
-        float getAmp() { return this->amp; }
-        float getAttack() { return this->attack; }
-        float getRelease() { return this->release; }
-        float getDecay() { return this->decay; }
-        float getSustain() { return this->sustain; }
-};
-
-class Sequence {
-    private:
-        TimeSignature ts;
-        std::vector<Note> notes;
-
-    public:
-        Sequence(TimeSignature ts) { this->ts = ts; }
-
-        void add(Note n) { notes.push_back(n); }
-
-    /**Add notes from the source sequence s,
-        *but starting on the beat indicated by startBeat
-        */
-    void addSequence(Sequence *s, float startBeat, float ampMult = 1.0) {
-        for(auto &note : *(s->getNotes())) { add(Note(note, startBeat, ampMult)); }
-    }
-
-    std::vector<Note> *getNotes() { return &notes; }
-};
+#include "WavetableEnv.hpp"
+#include "AdditiveEnv.hpp"
+#include "PolyphonyStress.hpp"
+#include "AudioProfile.hpp"
+#include "LatencyProbe.hpp"
+#include "MixGraph.hpp"
+#include "PhraseCache.hpp"
+#include "SampleVoice.hpp"
+#include "ScorePlayer.hpp"
+#include "NoteScheduler.hpp"
+#include "TempoMap.hpp"
+#include "Spatializer.hpp"
+#include "StreamRecorder.hpp"
+#include "RtSafety.hpp"
+#include "RtLog.hpp"
+#include "RealtimeConfig.hpp"
+#include "MidiFile.hpp"
+#include "NoteStream.hpp"
+#include "VoiceVisuals.hpp"
+#include "AnalysisTap.hpp"
 
 // We make an app.
 class MyApp : public App {
@@ -141,6 +57,77 @@ class MyApp : public App {
         // where the presets and sequences are stored
         SynthGUIManager<SineEnv> synthManager{"SineEnv"};
 
+        // Play the score with band-limited wavetable voices instead of sines
+        bool useWavetable = false;
+        // Or with stacks of partials
+        bool useAdditive = false;
+
+        // Ramps up voices at startup to find the sustainable polyphony
+        bool stressMode = false;
+        PolyphonyStress stress;
+        int stressVoices = 0;
+
+        // Device settings and the sub-block size voices are rendered at
+        AudioProfile profile{"default", 48000., 512, 512};
+        SubBlockRenderer subBlocks;
+
+        // Voices render into their own group bus, which feeds the master
+        MixGraph mix;
+        int voiceBus = 0;
+
+        // Play each phrase as one pre-rendered SampleVoice
+        bool useCache = false;
+        PhraseCache phraseCache;
+
+        // The score compiled at startup; key presses only reset its playhead
+        ScorePlayer scorePlayer;
+
+        // Batches of notes from playSequence and the MIDI and generated streams
+        NoteScheduler noteScheduler;
+        size_t reportedNoVoice = 0;
+
+        // Output channels; above two, voices are panned over a speaker ring
+        int outChannels = 2;
+
+        // Play a MIDI file instead of the built-in score. It is decoded a
+        // few seconds ahead of playback from onAnimate, so long files
+        // start at once.
+        std::string midiPath;
+        MidiFile midi;
+        int64_t streamStart = 0;      // NoteScheduler frame of beat 0
+        double streamLookahead = 4.0; // seconds
+
+#ifdef __cpp_impl_coroutine
+        // Or play an endless generated piece, the score over a random walk,
+        // pulled from its coroutines with the same look-ahead
+        bool generate = false;
+        uint32_t generateSeed = 1;
+        NoteSource generated;
+#endif
+
+        // Culls and merges voice discs so drawing stays cheap at high polyphony
+        VoiceVisuals visuals;
+
+        // Meters and spectrum of the master bus, computed off the audio
+        // thread, drawn every frame and optionally sent over OSC
+        AnalysisTap analysisTap;
+        Analysis analysis;
+        Mesh spectrumMesh;
+        int analysisPort = 0;
+        osc::Send analysisSend;
+
+        // Thread priorities, CPU pinning and memory locking
+        RealtimeConfig realtime;
+
+        // Archive of everything sent to the device
+        std::string recordPath;
+        StreamRecorder recorder;
+        uint64_t reportedDrops = 0;
+
+        // Loopback measurement of input-to-output latency
+        bool measureLatency = false;
+        LatencyProbe latencyProbe;
+
         // This function is called right after the window is created
         // It provides a grphics context to initialize ParameterGUI
         // It's also a good place to put things that should
@@ -153,22 +140,167 @@ class MyApp : public App {
             gam::sampleRate(audioIO().framesPerSecond());
 
             imguiInit();
+            visuals.init();
+
+            // Allocate voices now rather than on the audio thread mid-score
+            if (realtime.voicePool > 0) {
+                if (useWavetable) {
+                    synthManager.synth().allocatePolyphony<WavetableEnv>(realtime.voicePool);
+                } else if (useAdditive) {
+                    synthManager.synth().allocatePolyphony<AdditiveEnv>(realtime.voicePool);
+                } else {
+                    synthManager.synth().allocatePolyphony<SineEnv>(realtime.voicePool);
+                }
+            }
 
             // Play example sequence. Comment this line to start from scratch
             // synthManager.synthSequencer().playSequence("synth1.synthSequence");
-            synthManager.synthRecorder().verbose(true);
+            // Score notes are logged by rtlog (--log score=debug) instead
+            synthManager.synthRecorder().verbose(false);
+
+            int renderFrames = std::min(profile.subBlockSize, (int)audioIO().framesPerBuffer());
+            subBlocks.configure(renderFrames, audioIO().framesPerSecond(), audioIO().channelsOut());
+            // Sized for the whole device block: the sub-block renderer falls
+            // back to it when the buffer isn't a multiple of the sub-block
+            mix.configure(audioIO().channelsOut(), audioIO().framesPerBuffer(),
+                          audioIO().framesPerSecond());
+            voiceBus = mix.addBus("voices");
+            noteScheduler.horizon = 2 * (int64_t)audioIO().framesPerSecond();
+            mix.addEffect(MixGraph::kMaster, std::make_shared<SoftClip>());
+            printf("audio profile %s: %.0f Hz, %d frame blocks (%.2f ms), %d frame sub-blocks\n",
+                   profile.name.c_str(), profile.sampleRate, profile.blockSize,
+                   profile.blockMs(), subBlocks.size());
+
+            // onAnimate adds the voices the score needs once it is compiled
+            scorePlayer.compileAsync(1.0, BPM, audioIO().framesPerSecond());
+
+            if (useCache) {
+                // Render the score once up front so the first key press
+                // already plays from the cache
+                phraseCache.configure(audioIO().framesPerSecond(), BPM);
+                for (int n = 1; n <= kNumPhrases; n++) {
+                    Sequence *phrase = sequencePhrase(n);
+                    phraseCache.get(*phrase, 1.0, phraseAmp);
+                    delete phrase;
+                }
+                printf("phrase cache: %d phrases rendered, %d repeats, %.1f MB\n",
+                       phraseCache.misses(), phraseCache.hits(), phraseCache.bytes() / 1048576.0);
+            }
+
+            if (stressMode) {
+                stressVoices = 0;
+                stress.start();
+            }
+            if (measureLatency) {
+                latencyProbe.start();
+            }
+            analysisTap.start(audioIO().channelsOut(), audioIO().framesPerSecond());
+            if (analysisPort > 0) {
+                analysisSend.open(analysisPort, "localhost");
+            }
+            if (!recordPath.empty() &&
+                recorder.start(recordPath, audioIO().channelsOut(), audioIO().framesPerSecond())) {
+                printf("recording to %s\n", recordPath.c_str());
+            }
         }
 
         // The audio callback function. Called when audio hardware requires data
         void onSound(AudioIOData &io) override {
+            RT_SAFETY_SCOPE("onSound");
+            realtime.applyAudioThread();
+
             // THIS THIS THIS is where Andres suggests scheduling new events
             // define a counter... when I get here add the number of samples in block
             // when you get to target number, inject new sequence...
 
-            synthManager.render(io); // Render audio
+            if (stress.running()) {
+                // Held notes spread over four octaves from A2, scheduled
+                // from the audio thread so they start on this block
+                int n = stress.voicesToAdd();
+                for (int i = 0; i < n; i++, stressVoices++) {
+                    float freq = kConcertPitch.freq(45 + stressVoices % 48);
+                    playNote(freq, 0, 1e6, 0.5f / stress.maxVoices);
+                }
+                stress.voicesAdded(n);
+                stress.beginBlock();
+            }
+
+            // Render audio, in sub-blocks if the profile asks for them
+            subBlocks.render(io, [this](AudioIOData &block) {
+                if (useWavetable) {
+                    scorePlayer.process<WavetableEnv>(block, synthManager.synth());
+                } else if (useAdditive) {
+                    scorePlayer.process<AdditiveEnv>(block, synthManager.synth());
+                } else {
+                    scorePlayer.process<SineEnv>(block, synthManager.synth());
+                }
+                noteScheduler.process(block, synthManager.synth());
+                mix.beginBlock(block.framesPerBuffer());
+                mix.renderGroup(voiceBus, [this](AudioIOData &group) { synthManager.render(group); });
+                mix.process(block);
+            });
+            visuals.capture(synthManager.synth());
+
+            if (stress.running()) {
+                stress.endBlock(io);
+            }
+            latencyProbe.process(io);
+            analysisTap.process(io);
+            recorder.process(io);
         }
 
         void onAnimate(double dt) override {
+            int voices;
+            double renderMs, deadlineMs;
+            if (stress.finished(voices, renderMs, deadlineMs)) {
+                synthManager.synthSequencer().stopSequence();
+                synthManager.synth().allNotesOff();
+                printf("stress: %d voices sustainable at %d frames, %.0f Hz "
+                       "(%.3f ms of %.3f ms deadline, limit %.0f%%)\n",
+                       voices, (int)audioIO().framesPerBuffer(), audioIO().framesPerSecond(),
+                       renderMs, deadlineMs, stress.deadlineShare * 100.f);
+            }
+            if (useWavetable) {
+                scorePlayer.prepare<WavetableEnv>(synthManager.synth());
+            } else if (useAdditive) {
+                scorePlayer.prepare<AdditiveEnv>(synthManager.synth());
+            } else {
+                scorePlayer.prepare<SineEnv>(synthManager.synth());
+            }
+            double keyMs;
+            if (scorePlayer.lastLatency(keyMs)) {
+                printf("key press to first sample: %.2f ms\n", keyMs);
+            }
+            double minMs, meanMs, maxMs;
+            int missed;
+            if (latencyProbe.finished(minMs, meanMs, maxMs, missed)) {
+                printf("latency (%s): min %.2f ms, mean %.2f ms, max %.2f ms, %d missed\n",
+                       profile.name.c_str(), minMs, meanMs, maxMs, missed);
+            }
+
+            if (analysisTap.latest(analysis) && analysisPort > 0) {
+                sendAnalysis();
+            }
+
+            streamMidi();
+#ifdef __cpp_impl_coroutine
+            streamGenerated();
+#endif
+            // Long batches are handed to the audio thread as they come due
+            noteScheduler.update(synthManager.synth());
+            if (noteScheduler.noVoice() != reportedNoVoice) {
+                rtlog::warn(rtlog::kScore, "{} scheduled notes found no free voice",
+                            noteScheduler.noVoice() - reportedNoVoice);
+                reportedNoVoice = noteScheduler.noVoice();
+            }
+            if (realtime.audioReady()) {
+                printf("%s", realtime.report().c_str());
+            }
+            if (recorder.droppedFrames() != reportedDrops) {
+                reportedDrops = recorder.droppedFrames();
+                printf("recorder: disk too slow, %llu frames dropped\n", (unsigned long long)reportedDrops);
+            }
+
             // The GUI is prepared here
             imguiBeginFrame();
             // Draw a window that contains the synth control panel
@@ -180,7 +312,8 @@ class MyApp : public App {
         void onDraw(Graphics &g) override {
             g.clear();
             // Render the synth's graphics
-            synthManager.render(g);
+            visuals.draw(g, width(), height(), lens().fovy());
+            drawAnalysis(g);
 
             // GUI is drawn here
             imguiDraw();
@@ -195,11 +328,31 @@ class MyApp : public App {
                 case 8: // Backspace to end sequence
                     synthManager.synthSequencer().setTime(0);
                     synthManager.synthSequencer().stopSequence();
+                    scorePlayer.stop();
+                    noteScheduler.stop();
+                    midi.close();
+#ifdef __cpp_impl_coroutine
+                    generated.close();
+#endif
                     return false;
                 default: // Starts a new sequence and ending any currently playing sequences
-                    synthManager.synthSequencer().setTime(0);
-                    synthManager.synthSequencer().stopSequence();
-                    playSequence(1.0);
+                    if (!midiPath.empty()) {
+                        synthManager.synthSequencer().setTime(0);
+                        synthManager.synthSequencer().stopSequence();
+                        playMidi();
+#ifdef __cpp_impl_coroutine
+                    } else if (generate) {
+                        synthManager.synthSequencer().setTime(0);
+                        synthManager.synthSequencer().stopSequence();
+                        playGenerated();
+#endif
+                    } else if (useCache) {
+                        synthManager.synthSequencer().setTime(0);
+                        synthManager.synthSequencer().stopSequence();
+                        playCachedSequence(1.0);
+                    } else {
+                        scorePlayer.retrigger();
+                    }
                     return false;
             }
         }
@@ -209,12 +362,30 @@ class MyApp : public App {
             // do nothing
         }
 
-        void onExit() override { imguiShutdown(); }
+        void onExit() override {
+            if (recorder.recording()) {
+                recorder.stop();
+                printf("recorded %.1f s to %s, %llu frames dropped\n",
+                       recorder.framesWritten() / audioIO().framesPerSecond(), recordPath.c_str(),
+                       (unsigned long long)recorder.droppedFrames());
+            }
+            analysisTap.stop();
+            if (analysisTap.droppedFrames() > 0) {
+                printf("analysis: %llu frames dropped\n", (unsigned long long)analysisTap.droppedFrames());
+            }
+            imguiShutdown();
+        }
 
-        void playNote(float freq, float time, float duration = 0.5, float amp = 0.2, float attack = 0.1, float decay = 0.5) {
+        void playNote(float freq, double time, float duration = 0.5, float amp = 0.2, float attack = 0.1, float decay = 0.5) {
             SynthVoice *voice;
 
-            voice = synthManager.synth().getVoice<SineEnv>();
+            if (useWavetable) {
+                voice = synthManager.synth().getVoice<WavetableEnv>();
+            } else if (useAdditive) {
+                voice = synthManager.synth().getVoice<AdditiveEnv>();
+            } else {
+                voice = synthManager.synth().getVoice<SineEnv>();
+            }
             voice->setInternalParameterValue("amplitude", amp);
             voice->setInternalParameterValue("frequency", freq);
             voice->setInternalParameterValue("attackTime", 0.01);
@@ -224,635 +395,227 @@ class MyApp : public App {
             synthManager.synthSequencer().addVoiceFromNow(voice, time, duration);
         }
 
-        Sequence *sequence(float offset = 1.0) {
-            TimeSignature t;
-            Sequence *result = new Sequence(t);
-
-            result->addSequence(sequencePhrase1(offset), dashLength * 0, 0.5);
-            result->addSequence(sequencePhrase2(offset), dashLength * 27, 0.5);
-            result->addSequence(sequencePhrase3(offset), dashLength * 27 * 2, 0.5);
-            result->addSequence(sequencePhrase4(offset), dashLength * 27 * 3, 0.5);
-            result->addSequence(sequencePhrase5(offset), dashLength * 27 * 4, 0.5);
-            result->addSequence(sequencePhrase6(offset), dashLength * 27 * 5, 0.5);
-            result->addSequence(sequencePhrase7(offset), dashLength * 27 * 6, 0.5);
-            result->addSequence(sequencePhrase8(offset), dashLength * 27 * 7, 0.5);
-            result->addSequence(sequencePhrase9(offset), dashLength * 27 * 8, 0.5);
-            result->addSequence(sequencePhrase10(offset), dashLength * 27 * 9, 0.5);
-            result->addSequence(sequencePhrase11(offset), dashLength * 27 * 10, 0.5);
-            result->addSequence(sequencePhrase12(offset), dashLength * 27 * 11, 0.5);
-            result->addSequence(sequencePhrase13(offset), dashLength * 27 * 12, 0.5);
-            result->addSequence(sequencePhrase14(offset), dashLength * 27 * 13, 0.5);
-            result->addSequence(sequencePhrase15(offset), dashLength * 27 * 14, 0.5);
-            result->addSequence(sequencePhrase16(offset), dashLength * 27 * 15, 0.5);
-            result->addSequence(sequencePhrase17(offset), dashLength * 27 * 16, 0.5);
-            result->addSequence(sequencePhrase18(offset), dashLength * 27 * 17, 0.5);
-
-            return result;
+        // Schedule notes as one batch, as voices of the current type
+        // With absolute, event frames are on NoteScheduler's clock.
+        void scheduleNotes(const std::vector<NoteEvent> &events, bool absolute = false) {
+            const VoiceTaker voice = useWavetable ? &takeVoice<WavetableEnv>
+                                   : useAdditive  ? &takeVoice<AdditiveEnv>
+                                                  : &takeVoice<SineEnv>;
+            noteScheduler.schedule(synthManager.synth(), events.data(), events.size(), voice, absolute);
         }
 
-        Sequence *sequencePhrase1(float offset = 1.0) {
-            TimeSignature t;
-            Sequence *result = new Sequence(t);
-
-            result->add(Note(D5 * offset, dashLength * 0, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D5 * offset, dashLength * 6, dottedHalfNote / 1000.f, amplitude, dottedHalfNote, dottedHalfNote));
-            result->add(Note(C5 * offset, dashLength * 25, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B4 * offset, dashLength * 3, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B2 * offset, dashLength * 0, wholeNote / 1000.f, amplitude, wholeNote, wholeNote));
-
-            return result;
-        }
-
-        Sequence *sequencePhrase2(float offset = 1.0) {
-            TimeSignature t;
-            Sequence *result = new Sequence(t);
-
-            result->add(Note(C5s * offset, dashLength * 4, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D5 * offset, dashLength * 22, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D5 * offset, dashLength * 26, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A4s * offset, dashLength * 2, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B4 * offset, dashLength * 19, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D3 * offset, dashLength * 19, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B2 * offset, dashLength * 22, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-
-            return result;
-        }
-
-        Sequence *sequencePhrase3(float offset = 1.0) {
-            TimeSignature t;
-            Sequence *result = new Sequence(t);
-
-            result->add(Note(D5 * offset, dashLength * 2, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D5 * offset, dashLength * 4, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D5 * offset, dashLength * 14, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D5 * offset, dashLength * 17, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D5 * offset, dashLength * 20, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D5 * offset, dashLength * 22, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B4 * offset, dashLength * 5, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B4 * offset, dashLength * 11, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B4 * offset, dashLength * 13, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B4 * offset, dashLength * 23, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D3 * offset, dashLength * 23, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B2 * offset, dashLength * 23, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-
-            return result;
-        }
-
-        Sequence *sequencePhrase4(float offset = 1.0) {
-            TimeSignature t;
-            Sequence *result = new Sequence(t);
-
-            result->add(Note(C5s * offset, dashLength * 6, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(C5s * offset, dashLength * 9, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(C5s * offset, dashLength * 12, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(C5s * offset, dashLength * 14, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(C5s * offset, dashLength * 24, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B4 * offset, dashLength * 3, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B4 * offset, dashLength * 5, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A4s * offset, dashLength * 15, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A4s * offset, dashLength * 21, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A4s * offset, dashLength * 24, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A3s * offset, dashLength * 15, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(C3s * offset, dashLength * 6, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(C3s * offset, dashLength * 12, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(C3s * offset, dashLength * 15, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(C3s * offset, dashLength * 24, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A2s * offset, dashLength * 6, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A2s * offset, dashLength * 12, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A2s * offset, dashLength * 24, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-
-            return result;
-        }
-
-        Sequence *sequencePhrase5(float offset = 1.0) {
-            TimeSignature t;
-            Sequence *result = new Sequence(t);
-
-            result->add(Note(C5s * offset, dashLength * 1, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(C5s * offset, dashLength * 4, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(C5s * offset, dashLength * 6, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D5 * offset, dashLength * 16, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D5 * offset, dashLength * 19, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D5 * offset, dashLength * 22, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D5 * offset, dashLength * 24, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A4 * offset, dashLength * 7, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A4 * offset, dashLength * 13, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B4 * offset, dashLength * 25, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D4 * offset, dashLength * 25, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A3s * offset, dashLength * 7, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B3 * offset, dashLength * 16, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B3 * offset, dashLength * 22, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B3 * offset, dashLength * 25, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(C3s * offset, dashLength * 4, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(C3s * offset, dashLength * 7, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D3 * offset, dashLength * 16, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D3 * offset, dashLength * 22, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D3 * offset, dashLength * 25, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A2s * offset, dashLength * 4, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B2 * offset, dashLength * 16, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B2 * offset, dashLength * 22, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-
-            return result;
-        }
-
-        Sequence *sequencePhrase6(float offset = 1.0) {
-            TimeSignature t;
-            Sequence *result = new Sequence(t);
-
-            result->add(Note(D5 * offset, dashLength * 8, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D5 * offset, dashLength * 11, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D5 * offset, dashLength * 14, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D5 * offset, dashLength * 16, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B4 * offset, dashLength * 5, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B4 * offset, dashLength * 17, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B4 * offset, dashLength * 23, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B4 * offset, dashLength * 25, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D4 * offset, dashLength * 17, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B3 * offset, dashLength * 8, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B3 * offset, dashLength * 14, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B3 * offset, dashLength * 17, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D3 * offset, dashLength * 8, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D3 * offset, dashLength * 14, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D3 * offset, dashLength * 17, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B2 * offset, dashLength * 8, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B2 * offset, dashLength * 14, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-
-            return result;
-        }
-
-        Sequence *sequencePhrase7(float offset = 1.0) {
-            TimeSignature t;
-            Sequence *result = new Sequence(t);
-
-            result->add(Note(C5 * offset, dashLength * 0, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(C5 * offset, dashLength * 3, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(C5 * offset, dashLength * 6, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(C5 * offset, dashLength * 8, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(C5 * offset, dashLength * 18, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(C5 * offset, dashLength * 21, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(C5 * offset, dashLength * 24, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A4 * offset, dashLength * 9, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A4 * offset, dashLength * 15, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A4 * offset, dashLength * 17, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(C4 * offset, dashLength * 9, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A3 * offset, dashLength * 0, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A3 * offset, dashLength * 6, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A3 * offset, dashLength * 9, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A3 * offset, dashLength * 18, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A3 * offset, dashLength * 24, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(C3 * offset, dashLength * 0, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(C3 * offset, dashLength * 6, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(C3 * offset, dashLength * 9, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(C3 * offset, dashLength * 18, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(C3 * offset, dashLength * 24, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A2 * offset, dashLength * 0, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A2 * offset, dashLength * 6, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A2 * offset, dashLength * 18, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A2 * offset, dashLength * 24, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-
-            return result;
-        }
-
-        Sequence *sequencePhrase8(float offset = 1.0) {
-            TimeSignature t;
-            Sequence *result = new Sequence(t);
-
-            result->add(Note(C5 * offset, dashLength * 0, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F5s * offset, dashLength * 10, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(E5 * offset, dashLength * 16, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D5 * offset, dashLength * 22, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B5 * offset, dashLength * 10, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A5 * offset, dashLength * 16, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(G5 * offset, dashLength * 22, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A4s * offset, dashLength * 1, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B4 * offset, dashLength * 10, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A4 * offset, dashLength * 16, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(G4 * offset, dashLength * 22, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(C4s * offset, dashLength * 1, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A3s * offset, dashLength * 1, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(C3s * offset, dashLength * 10, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B3 * offset, dashLength * 13, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A3 * offset, dashLength * 19, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(G3 * offset, dashLength * 26, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B2 * offset, dashLength * 10, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B2 * offset, dashLength * 16, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B2 * offset, dashLength * 22, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-
-            return result;
-        }
-  
-        Sequence *sequencePhrase9(float offset = 1.0) {
-            TimeSignature t;
-            Sequence *result = new Sequence(t);
-
-            result->add(Note(E5 * offset, dashLength * 2, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(C5s * offset, dashLength * 5, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(E5 * offset, dashLength * 17, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F5s * offset, dashLength * 5, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B4 * offset, dashLength * 2, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B4 * offset, dashLength * 17, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(E4 * offset, dashLength * 2, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F4s * offset, dashLength * 5, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(E4 * offset, dashLength * 17, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B3 * offset, dashLength * 5, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A3s * offset, dashLength * 11, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A3s * offset, dashLength * 17, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A3s * offset, dashLength * 23, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B2 * offset, dashLength * 2, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A2s * offset, dashLength * 8, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A2s * offset, dashLength * 14, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A2s * offset, dashLength * 20, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-
-            return result;
-        }
-
-        Sequence *sequencePhrase10(float offset = 1.0) {
-            TimeSignature t;
-            Sequence *result = new Sequence(t);
-
-            result->add(Note(F5s * offset, dashLength * 3, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F5s * offset, dashLength * 6, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(E5 * offset, dashLength * 12, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D5 * offset, dashLength * 18, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(E5 * offset, dashLength * 24, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B5 * offset, dashLength * 3, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B5 * offset, dashLength * 6, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A5 * offset, dashLength * 12, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(G5 * offset, dashLength * 18, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B4 * offset, dashLength * 24, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B4 * offset, dashLength * 3, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B4 * offset, dashLength * 6, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A4 * offset, dashLength * 12, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(G4 * offset, dashLength * 18, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(E4 * offset, dashLength * 24, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B3 * offset, dashLength * 6, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B3 * offset, dashLength * 9, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B3 * offset, dashLength * 12, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B3 * offset, dashLength * 15, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B3 * offset, dashLength * 18, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B3 * offset, dashLength * 21, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B3 * offset, dashLength * 24, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A3s * offset, dashLength * 3, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F3s * offset, dashLength * 6, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F3s * offset, dashLength * 9, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F3s * offset, dashLength * 12, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F3s * offset, dashLength * 15, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F3s * offset, dashLength * 18, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F3s * offset, dashLength * 21, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F3s * offset, dashLength * 24, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A2 * offset, dashLength * 0, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B2 * offset, dashLength * 6, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B2 * offset, dashLength * 9, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B2 * offset, dashLength * 12, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B2 * offset, dashLength * 15, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B2 * offset, dashLength * 18, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B2 * offset, dashLength * 21, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B2 * offset, dashLength * 24, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-
-            return result;
+        void playSequence(Sequence *s, float bpm) {
+            // Beats to exact sample frames, all notes in one batch
+            TempoMap tempo(audioIO().framesPerSecond(), bpm);
+            std::vector<NoteEvent> events;
+            NoteScheduler::fromSequence(*s, tempo, events);
+            scheduleNotes(events);
+        }
+
+        // Same as playSequence(offset, bpm), but each phrase is scheduled as
+        // a single voice playing its cached rendering
+        void playCachedSequence(float offset = 1.0, float bpm = 77.0) {
+            TempoMap tempo(audioIO().framesPerSecond(), bpm);
+            phraseCache.configure(audioIO().framesPerSecond(), bpm);
+
+            for (int n = 1; n <= kNumPhrases; n++) {
+                Sequence *phrase = sequencePhrase(n, offset);
+                auto buffer = phraseCache.get(*phrase, offset, phraseAmp);
+                delete phrase;
+
+                SampleVoice *voice = synthManager.synth().getVoice<SampleVoice>();
+                voice->buffer(buffer);
+                synthManager.synthSequencer().addVoiceFromNow(
+                    voice, tempo.secondsAtBeat(phraseStartBeat(n)), buffer->frames() / audioIO().framesPerSecond());
+            }
         }
 
-        Sequence *sequencePhrase11(float offset = 1.0) {
-            TimeSignature t;
-            Sequence *result = new Sequence(t);
-
-            result->add(Note(F5s * offset, dashLength * 13, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A5s * offset, dashLength * 13, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(C5s * offset, dashLength * 1, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(C5s * offset, dashLength * 13, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F5s * offset, dashLength * 1, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(E5 * offset, dashLength * 13, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F4s * offset, dashLength * 1, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B3 * offset, dashLength * 1, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A3s * offset, dashLength * 4, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A3s * offset, dashLength * 7, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A3s * offset, dashLength * 10, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A3s * offset, dashLength * 13, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F3s * offset, dashLength * 1, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F3 * offset, dashLength * 4, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F3 * offset, dashLength * 7, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F3 * offset, dashLength * 10, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F3 * offset, dashLength * 13, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B2 * offset, dashLength * 1, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A2s * offset, dashLength * 4, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A2s * offset, dashLength * 7, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A2s * offset, dashLength * 10, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A2s * offset, dashLength * 13, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-
-            return result;
+        // Spectrum as a line along the bottom of the view, level as a bar
+        // at its left end; -90 to 0 dBFS, at the voice discs' depth
+        void drawAnalysis(Graphics &g) {
+            spectrumMesh.reset();
+            spectrumMesh.primitive(Mesh::LINE_STRIP);
+            for (int s = 0; s < Analysis::kSpectrumBins; s++) {
+                const float db = std::max(-90.f, analysis.spectrum[s]);
+                spectrumMesh.vertex(-4.f + 8.f * s / Analysis::kSpectrumBins, -3.f + (db + 90.f) / 60.f, -8);
+            }
+            g.color(0.6f, 0.8f, 1.f, 0.8f);
+            g.draw(spectrumMesh);
+
+            const float level = std::max(0.f, 1.f + 20.f * std::log10(std::max(analysis.rms, 1e-5f)) / 90.f);
+            spectrumMesh.reset();
+            spectrumMesh.primitive(Mesh::LINES);
+            spectrumMesh.vertex(-4.2f, -3.f, -8);
+            spectrumMesh.vertex(-4.2f, -3.f + 1.5f * level, -8);
+            g.color(analysis.peak >= 1.f ? 1.f : 0.4f, 1.f, 0.4f, 0.9f);
+            g.draw(spectrumMesh);
+        }
+
+        // "/analysis/level" rms peak, "/analysis/bands" one dBFS per octave
+        void sendAnalysis() {
+            analysisSend.send("/analysis/level", analysis.rms, analysis.peak);
+            osc::Packet bands;
+            bands.beginMessage("/analysis/bands");
+            for (float db : analysis.bands) {
+                bands << db;
+            }
+            bands.endMessage();
+            analysisSend.send(bands);
         }
 
-        Sequence *sequencePhrase12(float offset = 1.0) {
-            TimeSignature t;
-            Sequence *result = new Sequence(t);
-
-            result->add(Note(E5 * offset, dashLength * 8, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F5s * offset, dashLength * 13, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(E5 * offset, dashLength * 14, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D5 * offset, dashLength * 16, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(E4 * offset, dashLength * 8, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F4s * offset, dashLength * 13, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(E4 * offset, dashLength * 14, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D4 * offset, dashLength * 16, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B4 * offset, dashLength * 17, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B3 * offset, dashLength * 17, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F3s * offset, dashLength * 2, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F3s * offset, dashLength * 5, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F3s * offset, dashLength * 11, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B3 * offset, dashLength * 17, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B3 * offset, dashLength * 23, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(C3s * offset, dashLength * 2, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(C3s * offset, dashLength * 5, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(C3s * offset, dashLength * 11, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F3 * offset, dashLength * 17, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F3 * offset, dashLength * 23, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F2s * offset, dashLength * 2, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F2s * offset, dashLength * 5, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F2s * offset, dashLength * 11, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B2 * offset, dashLength * 17, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B2 * offset, dashLength * 23, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-
-            return result;
+        // Restart the MIDI file from the top
+        void playMidi() {
+            if (!midi.open(midiPath)) {
+                printf("can't read MIDI file %s\n", midiPath.c_str());
+                midiPath.clear();
+                return;
+            }
+            startStream();
+            streamMidi();
         }
 
-        Sequence *sequencePhrase13(float offset = 1.0) {
+        // Schedule the notes of the next streamLookahead seconds
+        void streamMidi() {
+            if (midi.finished()) {
+                return;
+            }
             TimeSignature t;
-            Sequence *result = new Sequence(t);
-
-            result->add(Note(E5 * offset, dashLength * 0, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D5 * offset, dashLength * 2, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(E5 * offset, dashLength * 3, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D5 * offset, dashLength * 5, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(E5 * offset, dashLength * 6, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D5 * offset, dashLength * 8, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(E5 * offset, dashLength * 9, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D5 * offset, dashLength * 11, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(E5 * offset, dashLength * 12, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D5 * offset, dashLength * 14, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B5 * offset, dashLength * 15, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(E4 * offset, dashLength * 0, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D4 * offset, dashLength * 2, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(E4 * offset, dashLength * 3, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D4 * offset, dashLength * 5, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(E4 * offset, dashLength * 6, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D4 * offset, dashLength * 8, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(E4 * offset, dashLength * 9, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D4 * offset, dashLength * 11, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(E4 * offset, dashLength * 12, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D4 * offset, dashLength * 14, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B4 * offset, dashLength * 15, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B3 * offset, dashLength * 9, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B3 * offset, dashLength * 15, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B3 * offset, dashLength * 21, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F3s * offset, dashLength * 24, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F3s * offset, dashLength * 0, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F3s * offset, dashLength * 3, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F3s * offset, dashLength * 9, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F3s * offset, dashLength * 15, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F3s * offset, dashLength * 21, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(C3s * offset, dashLength * 24, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B2 * offset, dashLength * 0, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B2 * offset, dashLength * 3, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F2s * offset, dashLength * 0, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F2s * offset, dashLength * 3, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B2 * offset, dashLength * 9, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B2 * offset, dashLength * 15, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B2 * offset, dashLength * 21, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F2s * offset, dashLength * 24, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-
-            return result;
+            Sequence chunk(t);
+            midi.readUntil(streamBeat() + streamLookahead * BPM / 60.0, chunk);
+            scheduleStreamed(chunk);
         }
 
-        Sequence *sequencePhrase14(float offset = 1.0) {
-            TimeSignature t;
-            Sequence *result = new Sequence(t);
-
-            result->add(Note(E5 * offset, dashLength * 4, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F5s * offset, dashLength * 9, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(E5 * offset, dashLength * 10, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D5 * offset, dashLength * 12, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(E5 * offset, dashLength * 22, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D5 * offset, dashLength * 24, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(E5 * offset, dashLength * 25, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(E4 * offset, dashLength * 4, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F4s * offset, dashLength * 9, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(E4 * offset, dashLength * 10, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D4 * offset, dashLength * 12, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B4 * offset, dashLength * 12, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(E4 * offset, dashLength * 22, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D4 * offset, dashLength * 24, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(E4 * offset, dashLength * 25, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B3 * offset, dashLength * 12, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F3s * offset, dashLength * 1, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F3s * offset, dashLength * 7, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B3 * offset, dashLength * 13, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B3 * offset, dashLength * 19, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(C3s * offset, dashLength * 1, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(C3s * offset, dashLength * 7, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F3s * offset, dashLength * 13, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F3s * offset, dashLength * 19, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F3s * offset, dashLength * 22, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F3s * offset, dashLength * 25, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B2 * offset, dashLength * 22, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B2 * offset, dashLength * 25, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F2s * offset, dashLength * 1, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F2s * offset, dashLength * 7, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B2s * offset, dashLength * 13, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B2s * offset, dashLength * 19, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F2s * offset, dashLength * 22, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F2s * offset, dashLength * 25, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-
-            return result;
+#ifdef __cpp_impl_coroutine
+        void playGenerated() {
+            generated = NoteSource(merge(score(1.0f), walk(generateSeed++)));
+            startStream();
+            streamGenerated();
         }
 
-        Sequence *sequencePhrase15(float offset = 1.0) {
+        void streamGenerated() {
+            if (generated.finished()) {
+                return;
+            }
             TimeSignature t;
-            Sequence *result = new Sequence(t);
-
-            result->add(Note(D6 * offset, dashLength * 20, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D5 * offset, dashLength * 1, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(E5 * offset, dashLength * 2, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D5 * offset, dashLength * 4, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B5 * offset, dashLength * 5, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D5 * offset, dashLength * 17, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D5 * offset, dashLength * 20, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B5 * offset, dashLength * 23, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D4 * offset, dashLength * 1, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(E4 * offset, dashLength * 2, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D4 * offset, dashLength * 4, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B4 * offset, dashLength * 5, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B4 * offset, dashLength * 13, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B4 * offset, dashLength * 14, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B4 * offset, dashLength * 16, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D4 * offset, dashLength * 17, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B4 * offset, dashLength * 23, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B3 * offset, dashLength * 13, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B3 * offset, dashLength * 14, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B3 * offset, dashLength * 16, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B3 * offset, dashLength * 5, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B3 * offset, dashLength * 11, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B3 * offset, dashLength * 17, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B3 * offset, dashLength * 20, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F3s * offset, dashLength * 5, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F3s * offset, dashLength * 11, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(F3s * offset, dashLength * 17, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D3 * offset, dashLength * 20, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B2 * offset, dashLength * 5, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B2 * offset, dashLength * 11, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B2 * offset, dashLength * 17, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B2 * offset, dashLength * 20, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-
-            return result;
+            Sequence chunk(t);
+            generated.readUntil(streamBeat() + streamLookahead * BPM / 60.0, chunk);
+            scheduleStreamed(chunk);
         }
+#endif
 
-        Sequence *sequencePhrase16(float offset = 1.0) {
-            TimeSignature t;
-            Sequence *result = new Sequence(t);
-
-            result->add(Note(D6 * offset, dashLength * 0, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D6 * offset, dashLength * 6, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D6 * offset, dashLength * 11, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D6 * offset, dashLength * 12, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D6 * offset, dashLength * 14, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D6 * offset, dashLength * 15, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D6 * offset, dashLength * 17, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(C6s * offset, dashLength * 18, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(C6s * offset, dashLength * 24, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D5 * offset, dashLength * 0, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D5 * offset, dashLength * 6, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D5 * offset, dashLength * 11, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D5 * offset, dashLength * 12, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D5 * offset, dashLength * 14, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D5 * offset, dashLength * 15, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D5 * offset, dashLength * 17, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(C5s * offset, dashLength * 18, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A5s * offset, dashLength * 21, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(C5s * offset, dashLength * 24, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A4s * offset, dashLength * 21, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(C4s * offset, dashLength * 18, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B3 * offset, dashLength * 0, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B3 * offset, dashLength * 11, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B3 * offset, dashLength * 12, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B3 * offset, dashLength * 14, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B3 * offset, dashLength * 15, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B3 * offset, dashLength * 17, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A3s * offset, dashLength * 18, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D3 * offset, dashLength * 0, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D3 * offset, dashLength * 11, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D3 * offset, dashLength * 12, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D3 * offset, dashLength * 14, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D3 * offset, dashLength * 15, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D3 * offset, dashLength * 17, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(C3s * offset, dashLength * 18, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B2 * offset, dashLength * 0, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B2 * offset, dashLength * 11, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B2 * offset, dashLength * 12, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B2 * offset, dashLength * 14, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B2 * offset, dashLength * 15, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B2 * offset, dashLength * 17, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-
-            return result;
+        // Streams are timed on the audio thread's sample clock, so they
+        // never drift from what is heard. Beat 0 is a block from now, so
+        // the first notes aren't already late.
+        void startStream() {
+            streamStart = noteScheduler.now() + audioIO().framesPerBuffer();
         }
 
-        Sequence *sequencePhrase17(float offset = 1.0) {
-            TimeSignature t;
-            Sequence *result = new Sequence(t);
-
-            result->add(Note(D6 * offset, dashLength * 16, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D6 * offset, dashLength * 22, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D5 * offset, dashLength * 13, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D5 * offset, dashLength * 16, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B5 * offset, dashLength * 19, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D5 * offset, dashLength * 22, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B4 * offset, dashLength * 9, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B4 * offset, dashLength * 10, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B4 * offset, dashLength * 12, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D4 * offset, dashLength * 13, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B4 * offset, dashLength * 19, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B3 * offset, dashLength * 9, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B3 * offset, dashLength * 10, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B3 * offset, dashLength * 12, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-
-            result->add(Note(B3 * offset, dashLength * 16, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B3 * offset, dashLength * 22, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-
-            result->add(Note(D3 * offset, dashLength * 16, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D3 * offset, dashLength * 22, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-
-            result->add(Note(B2 * offset, dashLength * 16, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B2 * offset, dashLength * 22, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-
-            return result;
+        // Beats played since the stream started
+        double streamBeat() {
+            return (noteScheduler.now() - streamStart) / audioIO().framesPerSecond() * BPM / 60.0;
         }
 
-        Sequence *sequencePhrase18(float offset = 1.0) {
-            TimeSignature t;
-            Sequence *result = new Sequence(t);
-
-            result->add(Note(D6 * offset, dashLength * 2, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D6 * offset, dashLength * 7, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D6 * offset, dashLength * 8, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D6 * offset, dashLength * 10, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D6 * offset, dashLength * 11, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D6 * offset, dashLength * 13, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(C6s * offset, dashLength * 14, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D5 * offset, dashLength * 2, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D5 * offset, dashLength * 7, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D5 * offset, dashLength * 8, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D5 * offset, dashLength * 10, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D5 * offset, dashLength * 11, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D5 * offset, dashLength * 13, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(C5s * offset, dashLength * 14, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(C4s * offset, dashLength * 14, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B3 * offset, dashLength * 7, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B3 * offset, dashLength * 8, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B3 * offset, dashLength * 10, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B3 * offset, dashLength * 11, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B3 * offset, dashLength * 13, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(A3s * offset, dashLength * 14, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D3 * offset, dashLength * 7, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D3 * offset, dashLength * 8, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D3 * offset, dashLength * 10, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D3 * offset, dashLength * 11, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(D3 * offset, dashLength * 13, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(C3s * offset, dashLength * 14, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B2 * offset, dashLength * 7, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B2 * offset, dashLength * 8, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B2 * offset, dashLength * 10, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B2 * offset, dashLength * 11, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-            result->add(Note(B2 * offset, dashLength * 13, quarterNote / 1000.f, amplitude, quarterNote, quarterNote));
-
-            return result;
-        }
-
-        void playSequence(Sequence *s, float bpm) {
-            float secondsPerBeat = 60.0f / bpm;
-
-            std::vector<Note> *notes = s->getNotes();
-
-            for (auto &note : *notes)
-            {
-            playNote(
-                note.getFreq(),
-                note.getTime() * secondsPerBeat,
-                note.getDuration() * secondsPerBeat,
-                note.getAmp(),
-                note.getAttack(),
-                note.getDecay());
+        void scheduleStreamed(Sequence &chunk) {
+            if (chunk.getNotes()->empty()) {
+                return;
             }
+            std::vector<NoteEvent> events;
+            NoteScheduler::fromSequence(chunk, TempoMap(audioIO().framesPerSecond(), BPM), events);
+            for (NoteEvent &e : events) {
+                e.frame += streamStart;
+            }
+            scheduleNotes(events, true);
         }
 
         void playSequence(float offset = 1.0, float bpm = 77.0) {
             Sequence *mySequence = sequence(offset);
             playSequence(mySequence, bpm);
+            delete mySequence;
         }
 };
 
-int main() {
+int main(int argc, char *argv[]) {
+    rtlog::start();
+    rtlog::threadName("main");
     // Create app instance
     MyApp app;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--wavetable") == 0) {
+            app.useWavetable = true;
+        } else if (strcmp(argv[i], "--additive") == 0) {
+            app.useAdditive = true;
+        } else if (strcmp(argv[i], "--cache") == 0) {
+            app.useCache = true;
+        } else if (strcmp(argv[i], "--no-crossfade") == 0) {
+            // let notes from the previous pass ring out on retrigger
+            app.scorePlayer.crossfade = false;
+        } else if (strcmp(argv[i], "--loop") == 0) {
+            // repeat the score until stopped, sample-exact on every pass
+            app.scorePlayer.loop = true;
+        } else if (strcmp(argv[i], "--stress") == 0) {
+            // optional share of the block deadline, e.g. --stress 0.7
+            app.stressMode = true;
+            if (i + 1 < argc && atof(argv[i + 1]) > 0) {
+                app.stress.deadlineShare = atof(argv[++i]);
+            }
+        } else if (strcmp(argv[i], "--stress-step") == 0 && i + 1 < argc) {
+            // voices added per ramp step; 0 would never reach the ceiling
+            app.stress.step = atoi(argv[++i]);
+            if (app.stress.step <= 0) {
+                printf("bad stress step %s (a positive voice count)\n", argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--profile") == 0 && i + 1 < argc) {
+            // a built-in profile name or rate/block/sub, e.g. 48000/256/32
+            if (!AudioProfile::find(argv[++i], app.profile)) {
+                printf("unknown audio profile %s (try %s)\n", argv[i],
+                       AudioProfile::names().c_str());
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--channels") == 0 && i + 1 < argc) {
+            // e.g. --channels 8 for an octophonic ring
+            app.outChannels = std::max(2, std::min(64, atoi(argv[++i])));
+        } else if (strcmp(argv[i], "--midi") == 0 && i + 1 < argc) {
+            // a Standard MIDI File to play on key press
+            app.midiPath = argv[++i];
+#ifdef __cpp_impl_coroutine
+        } else if (strcmp(argv[i], "--generate") == 0) {
+            // optional seed for the walk, e.g. --generate 7
+            app.generate = true;
+            if (i + 1 < argc && atoi(argv[i + 1]) > 0) {
+                app.generateSeed = atoi(argv[++i]);
+            }
+#endif
+        } else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            // .wav for a float WAV file, anything else for raw floats
+            app.recordPath = argv[++i];
+        } else if (strcmp(argv[i], "--record-direct") == 0) {
+            // bypass the page cache when writing the recording
+            app.recorder.direct = true;
+        } else if (strcmp(argv[i], "--log") == 0 && i + 1 < argc) {
+            // e.g. --log score=debug,audio=warn
+            if (!rtlog::parseLevels(argv[++i])) {
+                printf("bad log levels %s\n%s\n", argv[i], rtlog::usage());
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--analysis-osc") == 0 && i + 1 < argc) {
+            // send meters and band levels to this localhost port every frame
+            app.analysisPort = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--measure-latency") == 0) {
+            // needs a cable from output 1 to input 1
+            app.measureLatency = true;
+        } else if (!app.realtime.parseArg(argc, argv, i)) {
+            printf("unknown option %s\nrealtime options: %s\n", argv[i], RealtimeConfig::usage());
+        }
+    }
+    if (app.outChannels > 2) {
+        SpeakerLayout::current(std::make_shared<SpeakerLayout>(SpeakerLayout::ring(app.outChannels)));
+    }
+    app.realtime.applyProcess();
     // Set up audio
-    app.configureAudio(48000., 512, 2, 0);
+    app.configureAudio(app.profile.sampleRate, app.profile.blockSize, app.outChannels,
+                       app.measureLatency ? 1 : 0);
     app.start();
+    rtlog::stop();
     return 0;
 }
\ No newline at end of file
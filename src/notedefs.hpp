@@ -1,109 +1,114 @@
 #ifndef NOTEDEFS_HPP
 #define NOTEDEFS_HPP
 
-const float A8 = 7040.00;
-const float A7 = A8 / 2.0;
-const float A6 = A7 / 2.0;
-const float A5 = A6 / 2.0;
-const float A4 = A5 / 2.0;
-const float A3 = A4 / 2.0;
-const float A2 = A3 / 2.0;
-const float A1 = A2 / 2.0;
-const float A8s = 7458.62;
-const float A7s = A8s / 2.0;
-const float A6s = A7s / 2.0;
-const float A5s = A6s / 2.0;
-const float A4s = A5s / 2.0;
-const float A3s = A4s / 2.0;
-const float A2s = A3s / 2.0;
-const float A1s = A2s / 2.0;
-const float B8 = 7902.13;
-const float B7 = B8 / 2.0;
-const float B6 = B7 / 2.0;
-const float B5 = B6 / 2.0;
-const float B4 = B5 / 2.0;
-const float B3 = B4 / 2.0;
-const float B2 = B3 / 2.0;
-const float B1 = B2 / 2.0;
-const float B8s = 7458.62;
-const float B7s = B8s / 2.0;
-const float B6s = B7s / 2.0;
-const float B5s = B6s / 2.0;
-const float B4s = B5s / 2.0;
-const float B3s = B4s / 2.0;
-const float B2s = B3s / 2.0;
-const float B1s = B2s / 2.0;
-const float C8 = 4186.01;
-const float C7 = C8 / 2.0;
-const float C6 = C7 / 2.0;
-const float C5 = C6 / 2.0;
-const float C4 = C5 / 2.0;
-const float C3 = C4 / 2.0;
-const float C2 = C3 / 2.0;
-const float C1 = C2 / 2.0;
-const float C8s = 4434.92;
-const float C7s = C8s / 2.0;
-const float C6s = C7s / 2.0;
-const float C5s = C6s / 2.0;
-const float C4s = C5s / 2.0;
-const float C3s = C4s / 2.0;
-const float C2s = C3s / 2.0;
-const float C1s = C2s / 2.0;
-const float D8 = 4698.63;
-const float D7 = D8 / 2.0;
-const float D6 = D7 / 2.0;
-const float D5 = D6 / 2.0;
-const float D4 = D5 / 2.0;
-const float D3 = D4 / 2.0;
-const float D2 = D3 / 2.0;
-const float D1 = D2 / 2.0;
-const float D8s = 4978.03;
-const float D7s = D8s / 2.0;
-const float D6s = D7s / 2.0;
-const float D5s = D6s / 2.0;
-const float D4s = D5s / 2.0;
-const float D3s = D4s / 2.0;
-const float D2s = D3s / 2.0;
-const float D1s = D2s / 2.0;
-const float E8 = 5274.04;
-const float E7 = E8 / 2.0;
-const float E6 = E7 / 2.0;
-const float E5 = E6 / 2.0;
-const float E4 = E5 / 2.0;
-const float E3 = E4 / 2.0;
-const float E2 = E3 / 2.0;
-const float E1 = E2 / 2.0;
-const float F8 = 5587.65;
-const float F7 = F8 / 2.0;
-const float F6 = F7 / 2.0;
-const float F5 = F6 / 2.0;
-const float F4 = F5 / 2.0;
-const float F3 = F4 / 2.0;
-const float F2 = F3 / 2.0;
-const float F1 = F2 / 2.0;
-const float F8s = 5919.91;
-const float F7s = F8s / 2.0;
-const float F6s = F7s / 2.0;
-const float F5s = F6s / 2.0;
-const float F4s = F5s / 2.0;
-const float F3s = F4s / 2.0;
-const float F2s = F3s / 2.0;
-const float F1s = F2s / 2.0;
-const float G8 = 6271.93;
-const float G7 = G8 / 2.0;
-const float G6 = G7 / 2.0;
-const float G5 = G6 / 2.0;
-const float G4 = G5 / 2.0;
-const float G3 = G4 / 2.0;
-const float G2 = G3 / 2.0;
-const float G1 = G2 / 2.0;
-const float G8s = 6644.88;
-const float G7s = G8s / 2.0;
-const float G6s = G7s / 2.0;
-const float G5s = G6s / 2.0;
-const float G4s = G5s / 2.0;
-const float G3s = G4s / 2.0;
-const float G2s = G3s / 2.0;
-const float G1s = G2s / 2.0;
+#include "Tuning.hpp"
 
-#endif
\ No newline at end of file
+// Note names for the score, looked up at compile time in the 440 Hz
+// equal-tempered table. An "s" suffix is a sharp: C5s is C#5, MIDI 73.
+
+constexpr float A8 = kConcertPitch.freq(117);
+constexpr float A7 = kConcertPitch.freq(105);
+constexpr float A6 = kConcertPitch.freq(93);
+constexpr float A5 = kConcertPitch.freq(81);
+constexpr float A4 = kConcertPitch.freq(69);
+constexpr float A3 = kConcertPitch.freq(57);
+constexpr float A2 = kConcertPitch.freq(45);
+constexpr float A1 = kConcertPitch.freq(33);
+constexpr float A8s = kConcertPitch.freq(118);
+constexpr float A7s = kConcertPitch.freq(106);
+constexpr float A6s = kConcertPitch.freq(94);
+constexpr float A5s = kConcertPitch.freq(82);
+constexpr float A4s = kConcertPitch.freq(70);
+constexpr float A3s = kConcertPitch.freq(58);
+constexpr float A2s = kConcertPitch.freq(46);
+constexpr float A1s = kConcertPitch.freq(34);
+constexpr float B8 = kConcertPitch.freq(119);
+constexpr float B7 = kConcertPitch.freq(107);
+constexpr float B6 = kConcertPitch.freq(95);
+constexpr float B5 = kConcertPitch.freq(83);
+constexpr float B4 = kConcertPitch.freq(71);
+constexpr float B3 = kConcertPitch.freq(59);
+constexpr float B2 = kConcertPitch.freq(47);
+constexpr float B1 = kConcertPitch.freq(35);
+constexpr float B8s = kConcertPitch.freq(120);
+constexpr float B7s = kConcertPitch.freq(108);
+constexpr float B6s = kConcertPitch.freq(96);
+constexpr float B5s = kConcertPitch.freq(84);
+constexpr float B4s = kConcertPitch.freq(72);
+constexpr float B3s = kConcertPitch.freq(60);
+constexpr float B2s = kConcertPitch.freq(48);
+constexpr float B1s = kConcertPitch.freq(36);
+constexpr float C8 = kConcertPitch.freq(108);
+constexpr float C7 = kConcertPitch.freq(96);
+constexpr float C6 = kConcertPitch.freq(84);
+constexpr float C5 = kConcertPitch.freq(72);
+constexpr float C4 = kConcertPitch.freq(60);
+constexpr float C3 = kConcertPitch.freq(48);
+constexpr float C2 = kConcertPitch.freq(36);
+constexpr float C1 = kConcertPitch.freq(24);
+constexpr float C8s = kConcertPitch.freq(109);
+constexpr float C7s = kConcertPitch.freq(97);
+constexpr float C6s = kConcertPitch.freq(85);
+constexpr float C5s = kConcertPitch.freq(73);
+constexpr float C4s = kConcertPitch.freq(61);
+constexpr float C3s = kConcertPitch.freq(49);
+constexpr float C2s = kConcertPitch.freq(37);
+constexpr float C1s = kConcertPitch.freq(25);
+constexpr float D8 = kConcertPitch.freq(110);
+constexpr float D7 = kConcertPitch.freq(98);
+constexpr float D6 = kConcertPitch.freq(86);
+constexpr float D5 = kConcertPitch.freq(74);
+constexpr float D4 = kConcertPitch.freq(62);
+constexpr float D3 = kConcertPitch.freq(50);
+constexpr float D2 = kConcertPitch.freq(38);
+constexpr float D1 = kConcertPitch.freq(26);
+constexpr float D8s = kConcertPitch.freq(111);
+constexpr float D7s = kConcertPitch.freq(99);
+constexpr float D6s = kConcertPitch.freq(87);
+constexpr float D5s = kConcertPitch.freq(75);
+constexpr float D4s = kConcertPitch.freq(63);
+constexpr float D3s = kConcertPitch.freq(51);
+constexpr float D2s = kConcertPitch.freq(39);
+constexpr float D1s = kConcertPitch.freq(27);
+constexpr float E8 = kConcertPitch.freq(112);
+constexpr float E7 = kConcertPitch.freq(100);
+constexpr float E6 = kConcertPitch.freq(88);
+constexpr float E5 = kConcertPitch.freq(76);
+constexpr float E4 = kConcertPitch.freq(64);
+constexpr float E3 = kConcertPitch.freq(52);
+constexpr float E2 = kConcertPitch.freq(40);
+constexpr float E1 = kConcertPitch.freq(28);
+constexpr float F8 = kConcertPitch.freq(113);
+constexpr float F7 = kConcertPitch.freq(101);
+constexpr float F6 = kConcertPitch.freq(89);
+constexpr float F5 = kConcertPitch.freq(77);
+constexpr float F4 = kConcertPitch.freq(65);
+constexpr float F3 = kConcertPitch.freq(53);
+constexpr float F2 = kConcertPitch.freq(41);
+constexpr float F1 = kConcertPitch.freq(29);
+constexpr float F8s = kConcertPitch.freq(114);
+constexpr float F7s = kConcertPitch.freq(102);
+constexpr float F6s = kConcertPitch.freq(90);
+constexpr float F5s = kConcertPitch.freq(78);
+constexpr float F4s = kConcertPitch.freq(66);
+constexpr float F3s = kConcertPitch.freq(54);
+constexpr float F2s = kConcertPitch.freq(42);
+constexpr float F1s = kConcertPitch.freq(30);
+constexpr float G8 = kConcertPitch.freq(115);
+constexpr float G7 = kConcertPitch.freq(103);
+constexpr float G6 = kConcertPitch.freq(91);
+constexpr float G5 = kConcertPitch.freq(79);
+constexpr float G4 = kConcertPitch.freq(67);
+constexpr float G3 = kConcertPitch.freq(55);
+constexpr float G2 = kConcertPitch.freq(43);
+constexpr float G1 = kConcertPitch.freq(31);
+constexpr float G8s = kConcertPitch.freq(116);
+constexpr float G7s = kConcertPitch.freq(104);
+constexpr float G6s = kConcertPitch.freq(92);
+constexpr float G5s = kConcertPitch.freq(80);
+constexpr float G4s = kConcertPitch.freq(68);
+constexpr float G3s = kConcertPitch.freq(56);
+constexpr float G2s = kConcertPitch.freq(44);
+constexpr float G1s = kConcertPitch.freq(32);
+
+#endif